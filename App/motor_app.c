@@ -43,6 +43,76 @@
 #define MOTORAPP_CURRENT_MIN_WINDOW_TICKS (420U)
 #endif
 
+/* 注入组硬件过采样倍数（1/2/4/8/16，1=关闭）：JDR 中为累加和，Start 之后不可更改 */
+#ifndef MOTORAPP_ADC_OVS_HW_RATIO
+#define MOTORAPP_ADC_OVS_HW_RATIO (1U)
+#endif
+
+/* 每个 PWM 周期同一通道最多重复转换次数（1/2/4），实际次数按下桥臂窗口逐周期决定 */
+#ifndef MOTORAPP_ADC_OVS_MAX_SAMPLES
+#define MOTORAPP_ADC_OVS_MAX_SAMPLES (1U)
+#endif
+
+/* 单次注入转换占用的 TIM1 tick：(12.5 + 12.5) ADC cycles @ 42.5MHz ≈ 0.59us ≈ 100 ticks @ 170MHz */
+#ifndef MOTORAPP_ADC_OVS_TICKS_PER_CONV
+#define MOTORAPP_ADC_OVS_TICKS_PER_CONV (100U)
+#endif
+
+/* 回调码值相对 12bit 的倍数，offset 与满量程都在这个倍数下计算 */
+#define MOTORAPP_ADC_COUNT_SCALE (MOTORAPP_ADC_OVS_HW_RATIO * MOTORAPP_ADC_OVS_MAX_SAMPLES)
+
+_Static_assert(MOTORAPP_ADC_COUNT_SCALE <= 16U, "ADC oversampling sum must fit in uint16_t");
+
+/* 硬件过采样把一次转换拉长 HW_RATIO 倍，最小采样窗口同步加长 */
+#define MOTORAPP_CURRENT_SAMPLE_WINDOW_TICKS                                                                                   \
+    (MOTORAPP_CURRENT_MIN_WINDOW_TICKS + ((MOTORAPP_ADC_OVS_HW_RATIO - 1U) * MOTORAPP_ADC_OVS_TICKS_PER_CONV))
+
+/* 电机相电阻/电感：由电流环 PI 反推（Kp = L*wc, Ki = R*wc, wc = 2*pi*1kHz） */
+#ifndef MOTORAPP_MOTOR_RS_OHM
+#define MOTORAPP_MOTOR_RS_OHM (0.224f)
+#endif
+
+#ifndef MOTORAPP_MOTOR_LS_H
+#define MOTORAPP_MOTOR_LS_H (18.0e-6f)
+#endif
+
+/* 表贴电机 Ld = Lq，分开给出供交叉耦合前馈 / 电流预测用（R 命令辨识后运行时更新） */
+#ifndef MOTORAPP_MOTOR_LD_H
+#define MOTORAPP_MOTOR_LD_H (MOTORAPP_MOTOR_LS_H)
+#endif
+
+#ifndef MOTORAPP_MOTOR_LQ_H
+#define MOTORAPP_MOTOR_LQ_H (MOTORAPP_MOTOR_LS_H)
+#endif
+
+/* 机械参数（实验数据/系统辨识/SpeedPI_Calc.m） */
+#ifndef MOTORAPP_MOTOR_J_KGM2
+#define MOTORAPP_MOTOR_J_KGM2 (1.74e-6f)
+#endif
+
+#ifndef MOTORAPP_MOTOR_B_NMS
+#define MOTORAPP_MOTOR_B_NMS (5.0e-6f)
+#endif
+
+#ifndef MOTORAPP_MOTOR_KT_NM_A
+#define MOTORAPP_MOTOR_KT_NM_A (0.00415f)
+#endif
+
+/* 库仑摩擦（estimate_inertia_friction.m 只辨识了 J/B，先为 0，用 U 命令现场调） */
+#ifndef MOTORAPP_MOTOR_TC_NM
+#define MOTORAPP_MOTOR_TC_NM (0.0f)
+#endif
+
+/* 采样窗口不足时 dq 电流预测开关（运行时可用 S0/S1 切换） */
+#ifndef MOTORAPP_CURRENT_PREDICT_ENABLE
+#define MOTORAPP_CURRENT_PREDICT_ENABLE (1U)
+#endif
+
+/* 连续预测上限：超过后回退到原始采样，避免模型误差累积 */
+#ifndef MOTORAPP_CURRENT_PREDICT_MAX_TICKS
+#define MOTORAPP_CURRENT_PREDICT_MAX_TICKS (8U)
+#endif
+
 #ifndef MOTORAPP_CURRENT_OFFSET_SAMPLES
 #define MOTORAPP_CURRENT_OFFSET_SAMPLES (1000U)
 #endif
@@ -64,6 +134,19 @@
 #define MOTORAPP_VBUS_FILTER_ALPHA (0.1f)
 #endif
 
+/* Vbus 欠压/过压（滤波后），超出停机，回到范围内（带回差）自动解除 */
+#ifndef MOTORAPP_VBUS_UV_V
+#define MOTORAPP_VBUS_UV_V (9.0f)
+#endif
+
+#ifndef MOTORAPP_VBUS_OV_V
+#define MOTORAPP_VBUS_OV_V (16.0f)
+#endif
+
+#ifndef MOTORAPP_VBUS_HYST_V
+#define MOTORAPP_VBUS_HYST_V (0.5f)
+#endif
+
 #ifndef MOTORAPP_I_LIMIT_A
 #define MOTORAPP_I_LIMIT_A (3.0f)
 #endif
@@ -72,6 +155,89 @@
 #define MOTORAPP_I_TRIP_A (6.0f)
 #endif
 
+/* 硬件过流门限（A，相电流峰值），默认与软件门限相同；Q 命令运行时修改 */
+#ifndef MOTORAPP_OCP_TRIP_A
+#define MOTORAPP_OCP_TRIP_A (MOTORAPP_I_TRIP_A)
+#endif
+
+/* TIM1 BRK2 数字滤波 BK2F：6 = fDTS/4、N=6，约 141ns @ 170MHz，滤掉下桥开通振铃 */
+#ifndef MOTORAPP_OCP_BRK2_FILTER
+#define MOTORAPP_OCP_BRK2_FILTER (6U)
+#endif
+
+/*
+ * I^2t 热模型 + 电流降额：电流圆半径（即 i_limit）随绕组/逆变器温度估计在 I_PEAK 和持续电流之间变化，
+ * 速度环限幅跟随电流圆。没有接温度传感器，环境温度取常数，参数按电机/散热手册估。
+ * 默认关闭（固定 I_LIMIT / 速度环 2A，模型只估温度供 D31 观察）：参数未经实测标定，且复位后模型从冷态起算，
+ * 热电机复位后会重新拿到峰值电流。标定后再置 1。
+ */
+#ifndef MOTORAPP_THERM_ENABLE
+#define MOTORAPP_THERM_ENABLE (0U)
+#endif
+
+/* 冷态允许的峰值电流（须低于 I_TRIP） */
+#ifndef MOTORAPP_I_PEAK_A
+#define MOTORAPP_I_PEAK_A (5.0f)
+#endif
+
+/* 热模型节拍：200 拍 = 10ms，期间每拍累加 |i|^2 */
+#ifndef MOTORAPP_THERM_DIV
+#define MOTORAPP_THERM_DIV (200U)
+#endif
+
+#ifndef MOTORAPP_THERM_T_AMB_C
+#define MOTORAPP_THERM_T_AMB_C (25.0f)
+#endif
+
+/* 电机两阶：绕组对外壳（快）+ 外壳对环境（慢），sum(gain) = 18.75 -> 持续电流 2A @ 100degC */
+#ifndef MOTORAPP_THERM_MOTOR_GAIN_FAST
+#define MOTORAPP_THERM_MOTOR_GAIN_FAST (6.75f)
+#endif
+
+#ifndef MOTORAPP_THERM_MOTOR_TAU_FAST_S
+#define MOTORAPP_THERM_MOTOR_TAU_FAST_S (30.0f)
+#endif
+
+#ifndef MOTORAPP_THERM_MOTOR_GAIN_SLOW
+#define MOTORAPP_THERM_MOTOR_GAIN_SLOW (12.0f)
+#endif
+
+#ifndef MOTORAPP_THERM_MOTOR_TAU_SLOW_S
+#define MOTORAPP_THERM_MOTOR_TAU_SLOW_S (600.0f)
+#endif
+
+#ifndef MOTORAPP_THERM_MOTOR_T_DERATE_C
+#define MOTORAPP_THERM_MOTOR_T_DERATE_C (80.0f)
+#endif
+
+#ifndef MOTORAPP_THERM_MOTOR_T_MAX_C
+#define MOTORAPP_THERM_MOTOR_T_MAX_C (100.0f)
+#endif
+
+/* 逆变器一阶（MOSFET 结到散热器），IHM08 余量大，默认持续电流约 8.7A，基本不参与降额 */
+#ifndef MOTORAPP_THERM_INV_GAIN
+#define MOTORAPP_THERM_INV_GAIN (1.0f)
+#endif
+
+#ifndef MOTORAPP_THERM_INV_TAU_S
+#define MOTORAPP_THERM_INV_TAU_S (10.0f)
+#endif
+
+#ifndef MOTORAPP_THERM_INV_T_DERATE_C
+#define MOTORAPP_THERM_INV_T_DERATE_C (80.0f)
+#endif
+
+#ifndef MOTORAPP_THERM_INV_T_MAX_C
+#define MOTORAPP_THERM_INV_T_MAX_C (100.0f)
+#endif
+
+/* 电流圆 / MTPA 表范围：热降额打开时到 I_PEAK，否则为固定的 I_LIMIT */
+#if (MOTORAPP_THERM_ENABLE != 0U)
+#define MOTORAPP_I_RANGE_A (MOTORAPP_I_PEAK_A)
+#else
+#define MOTORAPP_I_RANGE_A (MOTORAPP_I_LIMIT_A)
+#endif
+
 #ifndef MOTORAPP_ICTRL_KP
 #define MOTORAPP_ICTRL_KP (0.1131f)
 #endif
@@ -85,11 +251,65 @@
 #define MOTORAPP_BEMF_FF_ENABLE (1U)
 #endif
 
+/*
+ * dq 交叉耦合前馈 ud_ff = -we*Lq*iq，uq_ff = we*Ld*id：0 = 关，1 = 用电流给定，2 = 用本拍实测电流（X 命令切换）。
+ * 默认关闭：Ld/Lq 还没在高速下对比验证过（见 DEV_LOG 待测项），和扰动观测器一样先用 X1 手动打开。
+ */
+#ifndef MOTORAPP_DQ_DECOUPLE_MODE
+#define MOTORAPP_DQ_DECOUPLE_MODE (0U)
+#endif
+
 #ifndef MOTORAPP_BEMF_KE_V_PER_RAD_S
 /* Ke from Kv: Ke = 60 / (2*pi*Kv_rpm_per_V)  (units: V / (rad/s)) */
 #define MOTORAPP_BEMF_KE_V_PER_RAD_S (0.00415f)
 #endif
 
+/* 在线 RLS 参数跟踪（E 命令）：中断按窗口累加 dq 电压/电流/速度，主循环更新 R/Ke 和 J */
+#ifndef MOTORAPP_RLS_MODE
+/* 0 = 只估计，1 = R/Ke 写入反电动势前馈和电流环 Ki，2 = 再加 J 写入速度环前馈/扰动观测器 */
+#define MOTORAPP_RLS_MODE (0U)
+#endif
+
+#ifndef MOTORAPP_RLS_WIN_TICKS
+#define MOTORAPP_RLS_WIN_TICKS (200U)
+#endif
+
+#ifndef MOTORAPP_RLS_LAMBDA
+/* 每个窗口（10ms）一次，0.998 约等于 5s 记忆 */
+#define MOTORAPP_RLS_LAMBDA (0.998f)
+#endif
+
+#ifndef MOTORAPP_RLS_IQ_MIN_A
+#define MOTORAPP_RLS_IQ_MIN_A (0.3f)
+#endif
+
+#ifndef MOTORAPP_RLS_OMEGA_MIN_RAD_S
+#define MOTORAPP_RLS_OMEGA_MIN_RAD_S (20.0f)
+#endif
+
+#ifndef MOTORAPP_RLS_DIQ_MAX_A
+/* 窗口内 Iq 变化超过此值不算稳态（L*diq/dt 已扣除，只是防止 PI 过渡段） */
+#define MOTORAPP_RLS_DIQ_MAX_A (0.2f)
+#endif
+
+#ifndef MOTORAPP_RLS_U_MAG_MAX_PU
+/* 电压饱和时下发值不等于实际值，不用 */
+#define MOTORAPP_RLS_U_MAG_MAX_PU (0.5f)
+#endif
+
+#ifndef MOTORAPP_RLS_ACC_MIN_RAD_S2
+#define MOTORAPP_RLS_ACC_MIN_RAD_S2 (200.0f)
+#endif
+
+#ifndef MOTORAPP_RLS_APPLY_RANGE
+/* 写入时限制在参考值的 [1/RANGE, RANGE] 倍；参考值为最近一次 R/L 辨识或复位到的参数，不随 RLS 自身漂移 */
+#define MOTORAPP_RLS_APPLY_RANGE (2.0f)
+#endif
+
+/* 回归量缩放：Ke*omega、J*acc 与 R 同一量级 */
+#define MOTORAPP_RLS_OMEGA_SCALE (100.0f)
+#define MOTORAPP_RLS_ACC_SCALE (1000.0f)
+
 #ifndef MOTORAPP_SPEED_LOOP_DIV
 /* Speed loop update rate inside ADC ISR: spd_hz = CTRL_HZ / DIV. DIV=20 -> 1kHz. */
 #define MOTORAPP_SPEED_LOOP_DIV (20U)
@@ -111,9 +331,14 @@
 // #define MOTORAPP_SPDCTRL_KI (5.296767f)
 // #endif
 
+/* 速度环 Iq 限幅上限（另外还受电流圆剩余部分限制）；热降额打开时交给电流圆 */
 #ifndef MOTORAPP_SCTRL_IQ_LIMIT_A
+#if (MOTORAPP_THERM_ENABLE != 0U)
+#define MOTORAPP_SCTRL_IQ_LIMIT_A (MOTORAPP_I_PEAK_A)
+#else
 #define MOTORAPP_SCTRL_IQ_LIMIT_A (2.0f)
 #endif
+#endif
 
 /* 速度指令给定最小阈值，防止模拟信号波动启动速度环 */
 #ifndef MOTORAPP_SCTRL_STOP_EPS
@@ -125,6 +350,29 @@
 #define MOTORAPP_SCTRL_OMEGA_LIMIT_RAD_S (1600.0f)
 #endif
 
+/* 电压反馈弱磁（N 命令）：速度环运行时 |u| 接近限幅就给负 Id，Iq 受电流圆剩余部分限制 */
+#ifndef MOTORAPP_FW_ENABLE
+#define MOTORAPP_FW_ENABLE (0U)
+#endif
+
+#ifndef MOTORAPP_FW_KI
+/* A/(pu*s)；1600rad/s 时 d|u|/dId 约 we*Ld/Vbus = 0.017 pu/A，对应约 50Hz 的电压环 */
+#define MOTORAPP_FW_KI (20000.0f)
+#endif
+
+#ifndef MOTORAPP_FW_U_RATIO
+#define MOTORAPP_FW_U_RATIO (0.95f)
+#endif
+
+#ifndef MOTORAPP_FW_ID_MIN_A
+#define MOTORAPP_FW_ID_MIN_A (-2.0f)
+#endif
+
+#ifndef MOTORAPP_FW_OMEGA_LIMIT_RAD_S
+/* 弱磁打开时的速度指令上限（本电机 psi/Ld 约 33A，-2A 只能把磁链压低约 6%，再加过调制） */
+#define MOTORAPP_FW_OMEGA_LIMIT_RAD_S (2000.0f)
+#endif
+
 /* Iq LUT 补偿使能开关（前馈）：低速实验用（查表 + 线性插值） */
 #ifndef MOTORAPP_IQ_LUT_COMP_ENABLE
 #define MOTORAPP_IQ_LUT_COMP_ENABLE (0U)
@@ -164,11 +412,145 @@
 #define MOTORAPP_SPD_REF_K_A (2.0f)
 #endif
 
+/* 速度环 Iq 前馈 (J*a + B*omega + Tc*sign(omega)) / Kt，按给定轨迹算（运行时 J/B/U 调系数） */
+#ifndef MOTORAPP_SPD_FF_ENABLE
+#define MOTORAPP_SPD_FF_ENABLE (1U)
+#endif
+
+#ifndef MOTORAPP_SPD_FF_COUL_BAND_RAD_S
+#define MOTORAPP_SPD_FF_COUL_BAND_RAD_S (2.0f)
+#endif
+
+/* 负载转矩扰动观测器：一直在速度环节拍里估计（D22 监测），补偿到 Iq 默认关闭（G1 打开） */
+#ifndef MOTORAPP_DOB_ENABLE
+#define MOTORAPP_DOB_ENABLE (0U)
+#endif
+
+#ifndef MOTORAPP_DOB_BW_RAD_S
+/* 观测器带宽 rad/s，需高于速度环带宽（约 250 rad/s），否则比不加观测器还慢；精确离散，1ms 节拍下无上限 */
+#define MOTORAPP_DOB_BW_RAD_S (400.0f)
+#endif
+
+/* 位置环（P<deg>）：在速度环节拍里再分频，输出直接作为速度环给定（不再过速度 S 曲线） */
+#ifndef MOTORAPP_POS_LOOP_DIV
+/* pos_hz = spd_hz / DIV */
+#define MOTORAPP_POS_LOOP_DIV (1U)
+#endif
+
+#ifndef MOTORAPP_POSCTRL_KP
+#define MOTORAPP_POSCTRL_KP (50.0f)
+#endif
+
+#ifndef MOTORAPP_POSCTRL_KI
+#define MOTORAPP_POSCTRL_KI (0.0f)
+#endif
+
+/* 点到点移动的速度/加速度/加加速度上限（机械 rad） */
+#ifndef MOTORAPP_POS_V_MAX_RAD_S
+#define MOTORAPP_POS_V_MAX_RAD_S (100.0f)
+#endif
+
+#ifndef MOTORAPP_POS_A_MAX_RAD_S2
+#define MOTORAPP_POS_A_MAX_RAD_S2 (500.0f)
+#endif
+
+#ifndef MOTORAPP_POS_J_MAX_RAD_S3
+#define MOTORAPP_POS_J_MAX_RAD_S3 (5000.0f)
+#endif
+
+#if (MOTORAPP_SPEED_LOOP_DIV > 0U)
+#define MOTORAPP_POS_LOOP_DT_S                                                                                                 \
+    (((float)MOTORAPP_SPEED_LOOP_DIV) * ((float)MOTORAPP_POS_LOOP_DIV) * (1.0f / MOTORAPP_CTRL_HZ))
+#else
+#define MOTORAPP_POS_LOOP_DT_S (((float)MOTORAPP_POS_LOOP_DIV) * (1.0f / MOTORAPP_CTRL_HZ))
+#endif
+
 /* 电流环输出，电压矢量限幅(母线电压标幺值) */
 #ifndef MOTORAPP_V_LIMIT_PU
 #define MOTORAPP_V_LIMIT_PU (0.57735026919f) /* 1/sqrt(3) */
 #endif
 
+/* 过调制（区域 I/II -> 六拍）默认开关；开启后电压矢量限幅放宽到 2/pi，运行时可用 W0/W1 切换 */
+#ifndef MOTORAPP_PWM_OVM_ENABLE
+#define MOTORAPP_PWM_OVM_ENABLE (0U)
+#endif
+
+/* 零序注入方式默认值（SvpwmZsMode，0=连续 SVPWM），运行时可用 Z<n> 切换 */
+#ifndef MOTORAPP_PWM_ZS_MODE
+#define MOTORAPP_PWM_ZS_MODE (0U)
+#endif
+
+/* DPWM 切入/切出的电压矢量幅值（母线电压标幺值），中间为迟滞区 */
+#ifndef MOTORAPP_PWM_DPWM_ON_U_PU
+#define MOTORAPP_PWM_DPWM_ON_U_PU (0.35f)
+#endif
+
+#ifndef MOTORAPP_PWM_DPWM_OFF_U_PU
+#define MOTORAPP_PWM_DPWM_OFF_U_PU (0.30f)
+#endif
+
+/* 死区补偿幅值（占空比，0=关闭）：理论值约 Td/Ts = 1.88us/50us ≈ 0.038，运行时可用 K<duty> 修改或 K 自动辨识 */
+#ifndef MOTORAPP_DTC_DUTY
+#define MOTORAPP_DTC_DUTY (0.0f)
+#endif
+
+#ifndef MOTORAPP_DTC_DUTY_MAX
+#define MOTORAPP_DTC_DUTY_MAX (0.1f)
+#endif
+
+/* 死区补偿过零平滑带宽 */
+#ifndef MOTORAPP_DTC_I_BAND_A
+#define MOTORAPP_DTC_I_BAND_A (0.1f)
+#endif
+
+/* 死区辨识：静止 Id 台阶扫描参数 */
+#ifndef MOTORAPP_DTC_IDENT_I_MAX_A
+#define MOTORAPP_DTC_IDENT_I_MAX_A (1.5f)
+#endif
+
+#ifndef MOTORAPP_DTC_IDENT_STEPS
+#define MOTORAPP_DTC_IDENT_STEPS (12U)
+#endif
+
+#ifndef MOTORAPP_DTC_IDENT_SETTLE_S
+#define MOTORAPP_DTC_IDENT_SETTLE_S (0.05f)
+#endif
+
+#ifndef MOTORAPP_DTC_IDENT_AVG_S
+#define MOTORAPP_DTC_IDENT_AVG_S (0.05f)
+#endif
+
+/* 静止 R/Ld/Lq 辨识 + 电流环自整定（R 命令）：Id 两点求 R，再 PRBS 电压注入拟合 Ld/Lq */
+#ifndef MOTORAPP_RL_IDENT_I1_A
+#define MOTORAPP_RL_IDENT_I1_A (1.0f)
+#endif
+
+#ifndef MOTORAPP_RL_IDENT_I2_A
+#define MOTORAPP_RL_IDENT_I2_A (2.0f)
+#endif
+
+#ifndef MOTORAPP_RL_IDENT_DI_A
+/* 注入幅值 du = R*di；偏置 i1 大于 di，注入时相电流不过零，死区影响小 */
+#define MOTORAPP_RL_IDENT_DI_A (0.5f)
+#endif
+
+#ifndef MOTORAPP_RL_IDENT_SETTLE_S
+#define MOTORAPP_RL_IDENT_SETTLE_S (0.05f)
+#endif
+
+#ifndef MOTORAPP_RL_IDENT_AVG_S
+#define MOTORAPP_RL_IDENT_AVG_S (0.05f)
+#endif
+
+#ifndef MOTORAPP_RL_IDENT_INJ_S
+#define MOTORAPP_RL_IDENT_INJ_S (0.2f)
+#endif
+
+#ifndef MOTORAPP_ICTRL_BW_HZ
+/* 自整定默认电流环带宽：Kp = L*wc，Ki = R*wc（手算的 MOTORAPP_ICTRL_KP/KI 就是 1kHz） */
+#define MOTORAPP_ICTRL_BW_HZ (1000.0f)
+#endif
+
 #ifndef MOTORAPP_SPD_PLL_KP
 #define MOTORAPP_SPD_PLL_KP (1005.0f)
 #endif
@@ -177,6 +559,61 @@
 #define MOTORAPP_SPD_PLL_KI (252662.0f)
 #endif
 
+/* 速度环自整定（L 命令）：电流环给 ±I 加减速，RLS 辨识 J/B/Tc 后按穿越频率重算速度 PI 和 PLL */
+#ifndef MOTORAPP_SPD_ID_I_A
+#define MOTORAPP_SPD_ID_I_A (0.5f)
+#endif
+
+#ifndef MOTORAPP_SPD_ID_OMEGA_RAD_S
+#define MOTORAPP_SPD_ID_OMEGA_RAD_S (150.0f)
+#endif
+
+#ifndef MOTORAPP_SPD_ID_COAST_S
+#define MOTORAPP_SPD_ID_COAST_S (0.1f)
+#endif
+
+#ifndef MOTORAPP_SPD_ID_SEG_MAX_S
+/* 单个加速段上限，超时判失败（负载惯量太大时加大 I 或本值） */
+#define MOTORAPP_SPD_ID_SEG_MAX_S (2.0f)
+#endif
+
+#ifndef MOTORAPP_SPD_ID_WIN_S
+#define MOTORAPP_SPD_ID_WIN_S (0.01f)
+#endif
+
+#ifndef MOTORAPP_SPD_ID_SKIP_S
+#define MOTORAPP_SPD_ID_SKIP_S (0.01f)
+#endif
+
+#ifndef MOTORAPP_SPD_TUNE_BW_HZ
+/* 默认穿越频率：Kp = J*wc/Kt，Ki = Kp*wc/PI_RATIO（40Hz、RATIO=4 即 MOTORAPP_SPDCTRL_KP/KI） */
+#define MOTORAPP_SPD_TUNE_BW_HZ (40.0f)
+#endif
+
+#ifndef MOTORAPP_SPD_TUNE_PI_RATIO
+#define MOTORAPP_SPD_TUNE_PI_RATIO (4.0f)
+#endif
+
+#ifndef MOTORAPP_SPD_TUNE_PLL_RATIO
+/* PLL wn = RATIO * wc（zeta = 1：Kp = 2wn，Ki = wn^2；默认 80Hz 对 40Hz），角度观测器带宽同 wn */
+#define MOTORAPP_SPD_TUNE_PLL_RATIO (2.0f)
+#endif
+
+#ifndef MOTORAPP_SPD_OBS_MODE
+/* 速度反馈来源：0 = 二阶 PI-PLL，1 = 三阶角度跟踪观测器（两者都一直在跑，切换无扰） */
+#define MOTORAPP_SPD_OBS_MODE (0U)
+#endif
+
+#ifndef MOTORAPP_SPD_ATO_BW_RAD_S
+/* 三重极点位置；PLL 现参数等效 wn≈503rad/s、zeta=1 */
+#define MOTORAPP_SPD_ATO_BW_RAD_S (500.0f)
+#endif
+
+#ifndef MOTORAPP_SPD_ATO_IQ_FF
+/* 1: 用 Kt/J * iq 作为观测器的加速度前馈 */
+#define MOTORAPP_SPD_ATO_IQ_FF (1U)
+#endif
+
 /* MT835系统带宽寄存器地址 */
 #ifndef MOTORAPP_MT6835_REG_BW_ADDR
 #define MOTORAPP_MT6835_REG_BW_ADDR (0x011U)
@@ -197,6 +634,57 @@
 #define MOTORAPP_ENCODER_READ_DIV (1U) /* ADC 中断内的编码器读取频率 */
 #endif
 
+#ifndef MOTORAPP_ENC_STATUS_REJECT_MASK
+/* STATUS 中哪些位会让该帧角度被丢弃：默认只信任无报警帧（超速/弱磁/欠压） */
+#define MOTORAPP_ENC_STATUS_REJECT_MASK (MT6835_STATUS_MASK)
+#endif
+
+#ifndef MOTORAPP_ENC_BAD_MAX_TICKS
+/* 连续无有效角度的最大外推 tick 数，超过后锁存编码器故障（20kHz 下 8 tick = 0.4ms） */
+#define MOTORAPP_ENC_BAD_MAX_TICKS (8U)
+#endif
+
+#ifndef MOTORAPP_SAMPLE_BAD_MAX_TICKS
+/* 电流环运行中连续原始无效采样（窗口不足且没有预测）的上限，超过报 FAULT_SAMPLE_INVALID（20kHz 下 200 tick = 10ms） */
+#define MOTORAPP_SAMPLE_BAD_MAX_TICKS (200U)
+#endif
+
+#ifndef MOTORAPP_ISR_OVR_WIN_TICKS
+/* 控制中断超时频度统计窗口（20kHz 下 20000 拍 = 1s） */
+#define MOTORAPP_ISR_OVR_WIN_TICKS (20000U)
+#endif
+
+#ifndef MOTORAPP_ISR_OVR_MAX_PER_WIN
+/* 窗口内超时 + 丢拍超过该数报 FAULT_ISR_OVERRUN */
+#define MOTORAPP_ISR_OVR_MAX_PER_WIN (20U)
+#endif
+
+#ifndef MOTORAPP_ISR_OVR_REACT
+/* FAULT_ISR_OVERRUN 的处理策略：FAULT_REACT_WARN 只记录，STOP / LATCH 停机 */
+#define MOTORAPP_ISR_OVR_REACT (FAULT_REACT_WARN)
+#endif
+
+#ifndef MOTORAPP_ENC_TIM_TRIGGER
+/* 1: 编码器读取由 TIM1 CH4 比较事件（DMA 请求）启动，角度在本拍 ADC 完成前到达，同拍使用；0: ISR 末尾启动、下一拍使用 */
+#define MOTORAPP_ENC_TIM_TRIGGER (1U)
+#endif
+
+#ifndef MOTORAPP_ADC_TRIG_CCR
+/* ADC 注入触发点（上计数比较值，与 CubeMX 里 CH4 Pulse 一致，靠近波峰 = 下桥臂导通中点） */
+#define MOTORAPP_ADC_TRIG_CCR (4220U)
+#endif
+
+#ifndef MOTORAPP_ENC_TRIG_LEAD_TICKS
+/* SPI 启动提前量：6 字节 @10.6MHz ≈ 4.6us，加 DMA/中断余量取 8us ≈ 1360 tick @170MHz */
+#define MOTORAPP_ENC_TRIG_LEAD_TICKS (1360U)
+#endif
+
+#ifndef MOTORAPP_TIM_CLK_HZ
+#define MOTORAPP_TIM_CLK_HZ (170000000.0f)
+#endif
+
+#define MOTORAPP_ENC_TRIG_LEAD_S ((float)MOTORAPP_ENC_TRIG_LEAD_TICKS / MOTORAPP_TIM_CLK_HZ)
+
 #ifndef MOTORAPP_THETA_CTRL_PREDICT_ENABLE
 /* 1: theta_ctrl = theta_meas + omega_e * Tcomp, only for current loop control frame. */
 #define MOTORAPP_THETA_CTRL_PREDICT_ENABLE (1U)
@@ -212,6 +700,23 @@
     (MOTORAPP_THETA_CTRL_TCOMP_SCALE * (((float)MOTORAPP_ENCODER_READ_DIV) * (1.0f / MOTORAPP_CTRL_HZ)))
 #endif
 
+#ifndef MOTORAPP_ENC_LATCH_ON_CMD
+/*
+ * MT6835 的角度锁存时刻：1 = 收到读命令时，0 = CS 下降沿。定时器触发时 CS 仍在上一拍 ISR 末尾拉低，
+ * 按 CS 锁存则角度年龄和原流程一样。没实测前按 0，补偿时间不变。
+ */
+#define MOTORAPP_ENC_LATCH_ON_CMD (0U)
+#endif
+
+#ifndef MOTORAPP_THETA_CTRL_TCOMP_TRIG_S
+#if (MOTORAPP_ENC_LATCH_ON_CMD != 0U)
+/* 读命令锁存：角度少老了 (1/CTRL_HZ - 提前量)，从实验得到的补偿时间里扣掉；需要在高速下重新微调 */
+#define MOTORAPP_THETA_CTRL_TCOMP_TRIG_S (MOTORAPP_THETA_CTRL_TCOMP_S - ((1.0f / MOTORAPP_CTRL_HZ) - MOTORAPP_ENC_TRIG_LEAD_S))
+#else
+#define MOTORAPP_THETA_CTRL_TCOMP_TRIG_S (MOTORAPP_THETA_CTRL_TCOMP_S)
+#endif
+#endif
+
 // static void MotorApp_OnAdcPair(void *user, uint16_t adc1, uint16_t adc2);
 
 static volatile uint32_t g_mt6835_quiet_ticks = 0U;
@@ -267,7 +772,7 @@ static float MotorApp_ThetaCtrlDeltaRad(const MotorApp *ctx)
 
 #if (MOTORAPP_THETA_CTRL_PREDICT_ENABLE != 0U)
     const float omega_e_rad_s = ctx->calib.p.pole_pairs * ctx->dbg_omega_pll_rad_s;
-    return omega_e_rad_s * MOTORAPP_THETA_CTRL_TCOMP_S;
+    return omega_e_rad_s * ctx->theta_ctrl_tcomp_s;
 #else
     return 0.0f;
 #endif
@@ -293,37 +798,117 @@ static uint8_t MotorApp_Mt6835QuietActive(void)
     return (g_mt6835_quiet_ticks != 0U) ? 1U : 0U;
 }
 
-static void MotorApp_CalibStart(MotorApp *ctx)
+/* 各故障的处理策略（下标为 FaultCode）；过流、编码器锁存，Vbus 条件恢复即可重新使能 */
+static const uint8_t g_motorapp_fault_react[FAULT_COUNT] = {
+    [FAULT_OC_SW] = (uint8_t)FAULT_REACT_LATCH,
+    [FAULT_OC_HW] = (uint8_t)FAULT_REACT_LATCH,
+    [FAULT_OC_BKIN] = (uint8_t)FAULT_REACT_LATCH,
+    [FAULT_ENC_CRC] = (uint8_t)FAULT_REACT_LATCH,
+    [FAULT_ENC_TIMEOUT] = (uint8_t)FAULT_REACT_LATCH,
+    [FAULT_VBUS_UNDER] = (uint8_t)FAULT_REACT_STOP,
+    [FAULT_VBUS_OVER] = (uint8_t)FAULT_REACT_STOP,
+    [FAULT_SAMPLE_INVALID] = (uint8_t)FAULT_REACT_WARN,
+    [FAULT_ISR_OVERRUN] = (uint8_t)MOTORAPP_ISR_OVR_REACT,
+};
+
+/* 频率响应分析的注入点（H<pt>）：x 为被测环节输入，y 为输出 */
+#define MOTORAPP_FRA_PT_NONE (0U)
+#define MOTORAPP_FRA_PT_ID (1U)  /* id_ref 注入：x = id_ref，y = id（d 轴电流闭环） */
+#define MOTORAPP_FRA_PT_IQ (2U)  /* iq_cmd 注入：x = iq，y = omega（机械对象） */
+#define MOTORAPP_FRA_PT_SPD (3U) /* 速度给定注入：x = omega_ref，y = omega（速度闭环） */
+#define MOTORAPP_FRA_PT_UD (4U)  /* ud 注入：x = ud，y = id（电气对象 1/(R+sL)） */
+
+/*
+ * 统一停机（故障、停止命令、辨识中止共用）：先关输出，再清所有给定/环路/注入/辨识状态。
+ * 整段关中断，主循环调用时控制中断不会看到清了一半的状态；中断内调用时 PRIMASK 原样恢复。
+ */
+static void MotorApp_SafeStop(MotorApp *ctx)
 {
-    if (ctx == 0)
-    {
-        return;
-    }
-
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    (void)BspTim1Pwm_DisableOutputs(&ctx->pwm);
+    ctx->i_loop_enable_pending = 0U;
+    ctx->i_loop_enabled = 0U;
     ctx->spd_loop_enabled = 0U;
+    ctx->pos_loop_enabled = 0U;
     ctx->target_vel_rad_s = 0.0f;
-    FocSpeedCtrl_Reset(&ctx->spd_ctrl);
+    ctx->id_ref_a = 0.0f;
+    ctx->iq_ref_a = 0.0f;
     ctx->spd_loop_div_countdown = 0U;
+    FocSpeedCtrl_Reset(&ctx->spd_ctrl);
     SCurveVel_Reset(&ctx->spd_ref_plan, 0.0f);
     SignalLogSweep_Reset(&ctx->iq_sweep);
     ctx->iq_sweep_request_pending = 0U;
     ctx->iq_sweep_div_countdown = 0U;
     ctx->iq_sweep_a = 0.0f;
-
-    ctx->calib_done = 0U;
-    ctx->calib_fail = 0U;
     ctx->vtest_active = 0U;
-    ctx->i_loop_enabled = 0U;
-    ctx->i_loop_enable_pending = 0U;
-    ctx->iq_ref_a = 0.0f;
+    FreqResp_Stop(&ctx->fra);
+    ctx->fra_point = MOTORAPP_FRA_PT_NONE;
+    ctx->fra_request_pending = 0U;
+    ctx->fra_inj = 0.0f;
     FocCurrentCtrl_Reset(&ctx->i_ctrl);
-    (void)BspTim1Pwm_EnableOutputs(&ctx->pwm);
-    MotorCalib_Start(&ctx->calib, ctx->pos_mech_rad);
+    MotorCalib_Abort(&ctx->calib);
+    DeadTimeIdent_Abort(&ctx->dtc_ident);
+    RlIdent_Abort(&ctx->rl_ident);
+    SpeedIdent_Abort(&ctx->spd_ident);
+    __set_PRIMASK(primask);
 }
 
-static void MotorApp_CalibAbort(MotorApp *ctx)
+/* 上报故障（中断/主循环均可），按策略停机；同一故障持续存在时只在第一次动作 */
+static void MotorApp_RaiseFault(MotorApp *ctx, FaultCode code, float value)
 {
-    if (ctx == 0)
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (FaultMgr_Raise(&ctx->fault, code, HAL_GetTick(), value) != FAULT_REACT_WARN)
+    {
+        MotorApp_SafeStop(ctx);
+    }
+    __set_PRIMASK(primask);
+}
+
+static void MotorApp_ReleaseFault(MotorApp *ctx, FaultCode code)
+{
+    if ((ctx->fault.active_mask & FAULT_MGR_BIT(code)) == 0U)
+    {
+        return;
+    }
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    FaultMgr_Release(&ctx->fault, code);
+    __set_PRIMASK(primask);
+}
+
+/* 有锁存故障或仍存在的停机类故障时不允许使能输出 */
+static uint8_t MotorApp_FaultLatched(const MotorApp *ctx)
+{
+    return (FaultMgr_Blocking(&ctx->fault) != 0U) ? 1U : 0U;
+}
+
+/*
+ * 所有使能输出都走这里：故障检查、电流环使能（i_loop 非 0 时）和开 MOE 放在同一段关中断里，
+ * 检查之后中断里才报的故障不会被主循环随后的使能覆盖。返回 0 表示有阻止使能的故障，输出保持关闭。
+ */
+static uint8_t MotorApp_TryEnableOutputs(MotorApp *ctx, uint8_t i_loop)
+{
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    const uint8_t ok = (MotorApp_FaultLatched(ctx) == 0U) ? 1U : 0U;
+    if (ok != 0U)
+    {
+        if (i_loop != 0U)
+        {
+            FocCurrentCtrl_Reset(&ctx->i_ctrl);
+            ctx->i_loop_enabled = 1U;
+        }
+        (void)BspTim1Pwm_EnableOutputs(&ctx->pwm);
+    }
+    __set_PRIMASK(primask);
+    return ok;
+}
+
+static void MotorApp_CalibStart(MotorApp *ctx)
+{
+    if ((ctx == 0) || (MotorApp_FaultLatched(ctx) != 0U))
     {
         return;
     }
@@ -338,15 +923,29 @@ static void MotorApp_CalibAbort(MotorApp *ctx)
     ctx->iq_sweep_div_countdown = 0U;
     ctx->iq_sweep_a = 0.0f;
 
+    ctx->calib_done = 0U;
+    ctx->calib_fail = 0U;
     ctx->vtest_active = 0U;
     ctx->i_loop_enabled = 0U;
     ctx->i_loop_enable_pending = 0U;
     ctx->iq_ref_a = 0.0f;
     FocCurrentCtrl_Reset(&ctx->i_ctrl);
-    MotorCalib_Abort(&ctx->calib);
+    if (MotorApp_TryEnableOutputs(ctx, 0U) != 0U)
+    {
+        MotorCalib_Start(&ctx->calib, ctx->pos_mech_rad);
+    }
+}
+
+static void MotorApp_CalibAbort(MotorApp *ctx)
+{
+    if (ctx == 0)
+    {
+        return;
+    }
+
+    MotorApp_SafeStop(ctx);
     ctx->calib_done = 0U;
     ctx->calib_fail = 0U;
-    (void)BspTim1Pwm_DisableOutputs(&ctx->pwm);
 }
 
 /* 将逻辑枚举(AB/AC)翻译成真实的 ADC Channel 宏 */
@@ -378,8 +977,8 @@ static void MotorApp_MapCurrentPairChannels(CurrentSensePair pair, uint32_t *adc
     }
 }
 
-/* 将新选出的 pair 更新到 ADC 硬件通道映射，并覆盖 ctx->i_pair_active */
-static void MotorApp_ProgramCurrentPair(MotorApp *ctx, CurrentSensePair pair)
+/* 将新选出的 pair（及每通道转换次数）更新到 ADC 硬件通道映射，并覆盖 ctx->i_pair_active */
+static void MotorApp_ProgramCurrentPair(MotorApp *ctx, CurrentSensePair pair, uint8_t samples)
 {
     uint32_t adc1_ch = 0U;
     uint32_t adc2_ch = 0U;
@@ -390,10 +989,12 @@ static void MotorApp_ProgramCurrentPair(MotorApp *ctx, CurrentSensePair pair)
     }
 
     MotorApp_MapCurrentPairChannels(pair, &adc1_ch, &adc2_ch);
-    BspAdcInjPair_SetRank1Channels(&ctx->adc_inj, adc1_ch, adc2_ch);
+    BspAdcInjPair_SetChannels(&ctx->adc_inj, adc1_ch, adc2_ch, samples);
 
     /* 把配好的 pair 存进全局变量 */
     ctx->i_pair_active = pair;
+    ctx->i_adc_samples = ctx->adc_inj.samples;
+    ctx->i_pair_valid_active = 1U;
 }
 
 /* 通过给定ud uq计算三路pwm占空比并改变对应CCR值 */
@@ -410,21 +1011,570 @@ static void MotorApp_OutputVdqSc(MotorApp *ctx, float ud, float uq, float sin_th
 
     SvpwmOut out = {0};
     CurrentSense3ShuntDecision current_decision = {0};
-    Svpwm_Calc(u_alpha, u_beta, &out);
+    const float u_mag = sqrtf((u_alpha * u_alpha) + (u_beta * u_beta));
+
+    /* DPWM 按调制比带迟滞切入/切出：低调制比时不连续 PWM 的电流纹波代价大于开关损耗收益 */
+    if (ctx->pwm_zs_mode == (uint8_t)SVPWM_ZS_CONTINUOUS)
+    {
+        ctx->pwm_zs_active = 0U;
+    }
+    else if (u_mag >= MOTORAPP_PWM_DPWM_ON_U_PU)
+    {
+        ctx->pwm_zs_active = 1U;
+    }
+    else if (u_mag < MOTORAPP_PWM_DPWM_OFF_U_PU)
+    {
+        ctx->pwm_zs_active = 0U;
+    }
+
+    if ((ctx->pwm_ovm_enable != 0U) && (u_mag > MOTORAPP_V_LIMIT_PU))
+    {
+        Svpwm_CalcOvm(u_alpha, u_beta, &out);
+    }
+    else if (ctx->pwm_zs_active != 0U)
+    {
+        Svpwm_CalcZs(u_alpha, u_beta, (SvpwmZsMode)ctx->pwm_zs_mode, &out);
+    }
+    else
+    {
+        Svpwm_Calc(u_alpha, u_beta, &out);
+    }
+    /* 死区补偿：钳位相不开关，不补偿；辨识过程中关闭，否则会把补偿量本身辨识进去 */
+    if (ctx->dtc_ident.state != DEADTIME_IDENT_RUN)
+    {
+        DeadTimeComp_Apply(&ctx->dtc, ctx->ia_a, ctx->ib_a, ctx->ic_a, (uint8_t)(out.clamp_low | out.clamp_high),
+                           &out.duty_a, &out.duty_b, &out.duty_c);
+    }
     ctx->dbg_duty_a = out.duty_a;
     ctx->dbg_duty_b = out.duty_b;
     ctx->dbg_duty_c = out.duty_c;
-    CurrentSense3Shunt_SelectPair(out.duty_a, out.duty_b, out.duty_c, ctx->pwm.period, MOTORAPP_CURRENT_MIN_WINDOW_TICKS,
-                                  ctx->i_pair_active, &current_decision);
+
+    /* 钳位相的窗口由调制器直接给出：钳 0 的相整周期可采，钳 1 的相不可采 */
+    CurrentSense3Shunt_SelectPairClamped(out.duty_a, out.duty_b, out.duty_c, ctx->pwm.period,
+                                         MOTORAPP_CURRENT_SAMPLE_WINDOW_TICKS, out.clamp_low, out.clamp_high,
+                                         ctx->i_pair_active, &current_decision);
+
+    /* 窗口够长时同一通道连续转换 2/4 次求和；pair 无效或过调制时窗口本就不够，保持单次 */
+    uint8_t samples = 1U;
+    if ((ctx->i_adc_ovs_enable != 0U) && (current_decision.pair_valid != 0U) &&
+        (out.ovm_region == (uint8_t)SVPWM_OVM_LINEAR))
+    {
+        samples = CurrentSense_WindowSampleCount(current_decision.pair_window_ticks, MOTORAPP_CURRENT_SAMPLE_WINDOW_TICKS,
+                                                 (uint16_t)(MOTORAPP_ADC_OVS_HW_RATIO * MOTORAPP_ADC_OVS_TICKS_PER_CONV),
+                                                 (uint8_t)MOTORAPP_ADC_OVS_MAX_SAMPLES);
+    }
     ctx->dbg_svm_sector = out.sector;
+    ctx->dbg_svm_ovm_region = out.ovm_region;
+    ctx->dbg_svm_clamp_low = out.clamp_low;
     ctx->dbg_i_pair_next = (uint8_t)current_decision.pair;
     ctx->dbg_i_pair_valid = current_decision.pair_valid;
     ctx->dbg_i_valid_mask = current_decision.valid_mask;
     ctx->dbg_i_low_window_a_ticks = current_decision.low_window_a_ticks;
     ctx->dbg_i_low_window_b_ticks = current_decision.low_window_b_ticks;
     ctx->dbg_i_low_window_c_ticks = current_decision.low_window_c_ticks;
-    BspTim1Pwm_SetDuty(&ctx->pwm, out.duty_a, out.duty_b, out.duty_c);
-    MotorApp_ProgramCurrentPair(ctx, current_decision.pair);
+    ctx->dbg_i_pair_window_ticks = current_decision.pair_window_ticks;
+    /* Svpwm / 死区补偿输出已在 [0,1] 内，直接换算成 CCR 走整数快速路径 */
+    const float period_f = ctx->pwm.period_f;
+    BspTim1Pwm_SetCompare(&ctx->pwm, (uint32_t)((out.duty_a * period_f) + 0.5f), (uint32_t)((out.duty_b * period_f) + 0.5f),
+                          (uint32_t)((out.duty_c * period_f) + 0.5f));
+    MotorApp_ProgramCurrentPair(ctx, current_decision.pair, samples);
+    ctx->i_pair_valid_active = current_decision.pair_valid;
+}
+
+/* 本拍采样组合窗口不足：用上一拍 dq 状态预测本拍电流，再反变换回三相 */
+static uint8_t MotorApp_PredictPhaseCurrents(MotorApp *ctx)
+{
+    if ((ctx == 0) || (ctx->i_predict.run_ticks >= MOTORAPP_CURRENT_PREDICT_MAX_TICKS))
+    {
+        return 0U;
+    }
+
+    const float omega_e_rad_s = ctx->calib.p.pole_pairs * ctx->dbg_omega_pll_rad_s;
+    float eq_v = 0.0f;
+#if (MOTORAPP_BEMF_FF_ENABLE != 0U)
+    eq_v = ctx->motor_ke_v_s * ctx->dbg_omega_pll_rad_s;
+#endif
+
+    float id_a = 0.0f;
+    float iq_a = 0.0f;
+    if (CurrentPredictDq_Predict(&ctx->i_predict, omega_e_rad_s, eq_v, &id_a, &iq_a) == 0U)
+    {
+        return 0U;
+    }
+
+    /* 与电流环 Park 变换使用同一个角度，保证 abc -> dq 回到预测值 */
+    float s = 0.0f;
+    float c = 1.0f;
+    BspTrig_SinCos(ctx->theta_e_ctrl_rad, &s, &c);
+    const float i_alpha = (id_a * c) - (iq_a * s);
+    const float i_beta = (id_a * s) + (iq_a * c);
+
+    ctx->ia_a = i_alpha;
+    ctx->ib_a = (-0.5f * i_alpha) + (0.86602540378f * i_beta);
+    ctx->ic_a = -(ctx->ia_a + ctx->ib_a);
+    return 1U;
+}
+
+/*
+ * 热模型节拍（ISR，故障停机期间也跑，保证冷却照算）：每拍累加 |i_dq|^2（等幅值变换 = 2/3 * 三相平方和），
+ * 每 MOTORAPP_THERM_DIV 拍按均值推进 RC 网络，并把绕组/逆变器两者降额结果的较小值写到 i_limit 和电流圆半径。
+ */
+static void MotorApp_ThermalTick(MotorApp *ctx)
+{
+    if ((ctx->pwm.outputs_enabled != 0U) && (ctx->i_offset_ready != 0U))
+    {
+        ctx->therm_acc_i2 +=
+            0.66666667f * ((ctx->ia_a * ctx->ia_a) + (ctx->ib_a * ctx->ib_a) + (ctx->ic_a * ctx->ic_a));
+    }
+    ctx->therm_tick++;
+    if (ctx->therm_tick < MOTORAPP_THERM_DIV)
+    {
+        return;
+    }
+    const float i2 = ctx->therm_acc_i2 * (1.0f / (float)MOTORAPP_THERM_DIV);
+    ctx->therm_tick = 0U;
+    ctx->therm_acc_i2 = 0.0f;
+    ctx->therm_i2_a2 = i2;
+    (void)ThermalRc_Step(&ctx->therm_motor, i2);
+    (void)ThermalRc_Step(&ctx->therm_inv, i2);
+#if (MOTORAPP_THERM_ENABLE != 0U)
+    const float lim_m = ThermalRc_Derate(&ctx->therm_motor, MOTORAPP_I_PEAK_A);
+    const float lim_i = ThermalRc_Derate(&ctx->therm_inv, MOTORAPP_I_PEAK_A);
+    ctx->i_limit_a = (lim_m < lim_i) ? lim_m : lim_i;
+    CurrentVec_SetLimit(&ctx->ivec, ctx->i_limit_a);
+#endif
+}
+
+/*
+ * 硬件过流通道表。本板相电流运放输出在 PA0(A) / PC1(B) / PC0(C)：
+ * G431 上 PA0、PC1 只能进 COMP3 同相端（INPSEL 二选一），PC0 不是任何比较器的同相输入，
+ * 所以只盯 A 相一个方向：正电流采样电压低于零偏，比较器取反。电流信号改接 PA1/PA7/PB0（COMP1/2/4）后在表里加行即可。
+ */
+static const BspOcpCompChannel g_motorapp_ocp_ch[] = {
+    {
+        .comp = COMP3,
+        .inpsel = 0U, /* PA0 */
+        .inmsel = 4U, /* DAC3_CH1 */
+        .dac = DAC3,
+        .dac_ch = 1U,
+        .af2_en = TIM1_AF2_BK2CMP3E,
+        .invert = 1U,
+    },
+};
+static const uint8_t g_motorapp_ocp_phase[] = {0U}; /* 各通道对应的相（取该相零偏） */
+
+#define MOTORAPP_OCP_N_CH ((uint8_t)(sizeof(g_motorapp_ocp_ch) / sizeof(g_motorapp_ocp_ch[0])))
+
+_Static_assert(sizeof(g_motorapp_ocp_phase) == (sizeof(g_motorapp_ocp_ch) / sizeof(g_motorapp_ocp_ch[0])),
+               "one phase index per OCP channel");
+
+/* 观测器加速度前馈用的 iq：换到编码器原始方向（Iq>0 时 dbg 速度为正，原始方向差一个 elec_dir） */
+static float MotorApp_ObserverIqRaw(const MotorApp *ctx)
+{
+    return (ctx->i_loop_enabled != 0U) ? ((float)ctx->elec_dir * ctx->dbg_iq_a) : 0.0f;
+}
+
+/* 速度反馈（dbg_omega_pll_rad_s，速度环/前馈/打印共用）取自选中的估计器 */
+static void MotorApp_SelectSpeedFeedback(MotorApp *ctx)
+{
+    const float omega_raw = (ctx->spd_obs_mode != 0U) ? ctx->spd_ato.omega_rad_s : ctx->spd_omega_pll_rad_s;
+    ctx->dbg_omega_pll_rad_s = (float)ctx->elec_dir * omega_raw;
+}
+
+/* 用一帧有效角度更新位置、差分速度、PLL 和角度观测器 */
+static void MotorApp_EncoderAccept(MotorApp *ctx, uint32_t raw21)
+{
+    ctx->raw21 = raw21;
+    ctx->raw21_corr = Mt6835AngleCorr_ApplyRaw21(raw21);
+    ctx->pos_mech_rad = Mt6835_Raw21ToRad(ctx->raw21_corr);
+    MultiTurnPos_Update(&ctx->enc_mt, ctx->raw21_corr);
+
+    const float theta = ctx->pos_mech_rad;
+    const float dt = ((float)MOTORAPP_ENCODER_READ_DIV) * (1.0f / MOTORAPP_CTRL_HZ);
+    /* 第一次启动，速度计算初始化 */
+    if (ctx->spd_valid == 0U)
+    {
+        ctx->spd_valid = 1U;
+        ctx->spd_theta_prev_rad = theta;
+        ctx->spd_omega_diff_rad_s = 0.0f;
+        ctx->spd_pll_theta_hat_rad = theta;
+        ctx->spd_pll_omega_int_rad_s = 0.0f;
+        ctx->spd_omega_pll_rad_s = 0.0f;
+        AngleObserver3_Reset(&ctx->spd_ato, theta);
+    }
+    else
+    {
+        const float dtheta = MotorApp_WrapPi(theta - ctx->spd_theta_prev_rad);
+        ctx->spd_theta_prev_rad = theta;
+        ctx->spd_omega_diff_rad_s = dtheta / dt;
+
+        const float e = MotorApp_WrapPi(theta - ctx->spd_pll_theta_hat_rad);
+        ctx->spd_pll_omega_int_rad_s += (ctx->spd_pll_ki * e * dt);
+        ctx->spd_omega_pll_rad_s = ctx->spd_pll_omega_int_rad_s + (ctx->spd_pll_kp * e);
+        ctx->spd_pll_theta_hat_rad = MotorApp_Wrap2Pi(ctx->spd_pll_theta_hat_rad + (ctx->spd_omega_pll_rad_s * dt));
+
+        AngleObserver3_Update(&ctx->spd_ato, theta, MotorApp_ObserverIqRaw(ctx));
+    }
+
+    /* 统一符号：让 Iq>0 时 speed 为正（即使编码器角度递减，elec_dir=-1） */
+    ctx->dbg_omega_diff_rad_s = (float)ctx->elec_dir * ctx->spd_omega_diff_rad_s;
+    MotorApp_SelectSpeedFeedback(ctx);
+}
+
+/* 本拍没有可信角度：PLL/观测器按模型外推一拍，位置跟随选中估计器的外推值 */
+static void MotorApp_EncoderExtrapolate(MotorApp *ctx)
+{
+    if (ctx->spd_valid == 0U)
+    {
+        return;
+    }
+    /* 上一次更新末尾两个估计器都已前推一步，theta_hat 就是本拍的预测：先取用，再前推到下一拍 */
+    ctx->pos_mech_rad = (ctx->spd_obs_mode != 0U) ? ctx->spd_ato.theta_hat_rad : ctx->spd_pll_theta_hat_rad;
+    ctx->spd_theta_prev_rad = ctx->pos_mech_rad;
+    const float dt = ((float)MOTORAPP_ENCODER_READ_DIV) * (1.0f / MOTORAPP_CTRL_HZ);
+    ctx->spd_pll_theta_hat_rad = MotorApp_Wrap2Pi(ctx->spd_pll_theta_hat_rad + (ctx->spd_omega_pll_rad_s * dt));
+    AngleObserver3_Predict(&ctx->spd_ato, MotorApp_ObserverIqRaw(ctx));
+    MotorApp_SelectSpeedFeedback(ctx);
+}
+
+/* 多圈位置（用户方向：Iq>0 为正），相对 pos_origin_count */
+static float MotorApp_PosRelRad(const MotorApp *ctx)
+{
+    return (float)ctx->elec_dir * (float)(ctx->enc_mt.count - ctx->pos_origin_count) * MULTITURN_POS_RAD_PER_COUNT;
+}
+
+/* 主循环读多圈计数：int64 要两次 32bit 读，中间可能被中断改掉，关中断读整值 */
+static int64_t MotorApp_EncMtCountSnapshot(const MotorApp *ctx)
+{
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    const int64_t count = ctx->enc_mt.count;
+    __set_PRIMASK(primask);
+    return count;
+}
+
+/* 速度环 Iq 前馈（spd_ff_enable=0 时为 0） */
+static void MotorApp_SpeedFfUpdate(MotorApp *ctx, float acc_rad_s2, float omega_rad_s)
+{
+    ctx->spd_iq_ff_a = (ctx->spd_ff_enable != 0U) ? SpeedFf_Iq(&ctx->spd_ff, acc_rad_s2, omega_rad_s) : 0.0f;
+}
+
+/* 速度环给定：位置模式下由位置环给出，否则为速度指令经 S 曲线 */
+static float MotorApp_SpeedLoopRef(MotorApp *ctx)
+{
+    if (ctx->pos_loop_enabled != 0U)
+    {
+        if (ctx->pos_loop_div_countdown == 0U)
+        {
+            ctx->pos_loop_div_countdown = (uint16_t)(MOTORAPP_POS_LOOP_DIV - 1U);
+            if (ctx->pos_traj_ready != 0U)
+            {
+                /* 主循环规划好的新轨迹在这里接手（读标志之后再读轨迹） */
+                __DMB();
+                ctx->pos_traj = ctx->pos_traj_next;
+                ctx->pos_traj_base_rad = ctx->pos_traj_next_base_rad;
+                ctx->pos_traj_ready = 0U;
+            }
+            SCurvePos_Step(&ctx->pos_traj);
+            ctx->pos_ref_rad = ctx->pos_traj_base_rad + ctx->pos_traj.pos;
+            ctx->pos_ref_vel_rad_s = ctx->pos_traj.vel;
+            ctx->pos_ref_acc_rad_s2 = ctx->pos_traj.acc;
+            ctx->pos_err_rad = ctx->pos_ref_rad - MotorApp_PosRelRad(ctx);
+            ctx->pos_omega_ref_rad_s = FocPosCtrl_Step(&ctx->pos_ctrl, ctx->pos_err_rad, ctx->pos_ref_vel_rad_s);
+        }
+        else
+        {
+            ctx->pos_loop_div_countdown--;
+        }
+        /* 前馈用轨迹本身的速度/加速度，不用位置环修正后的速度给定 */
+        MotorApp_SpeedFfUpdate(ctx, ctx->pos_ref_acc_rad_s2, ctx->pos_ref_vel_rad_s);
+        /* 退出位置模式时速度 S 曲线从当前给定接着走 */
+        SCurveVel_Reset(&ctx->spd_ref_plan, ctx->pos_omega_ref_rad_s);
+        return ctx->pos_omega_ref_rad_s;
+    }
+
+    float omega_ref = ctx->target_vel_rad_s;
+#if (MOTORAPP_SPD_REF_S_CURVE_ENABLE != 0U)
+    omega_ref = SCurveVel_Step(&ctx->spd_ref_plan, omega_ref);
+    MotorApp_SpeedFfUpdate(ctx, ctx->spd_ref_plan.a, omega_ref);
+#else
+    /* 同步实际速度至S-Curve规划器内部状态，确保闭环瞬间速度平滑衔接 */
+    SCurveVel_Reset(&ctx->spd_ref_plan, omega_ref);
+    MotorApp_SpeedFfUpdate(ctx, 0.0f, omega_ref);
+#endif
+    return omega_ref;
+}
+
+/* 电机 R/L 写入运行时参数和依赖它们的 dq 电流预测 */
+static void MotorApp_ApplyMotorRl(MotorApp *ctx, float rs_ohm, float ld_h, float lq_h)
+{
+    ctx->motor_rs_ohm = rs_ohm;
+    ctx->motor_ld_h = ld_h;
+    ctx->motor_lq_h = lq_h;
+    ctx->rls_r_ref_ohm = rs_ohm;
+    CurrentPredictDq_Init(&ctx->i_predict, rs_ohm, 0.5f * (ld_h + lq_h), 1.0f / MOTORAPP_CTRL_HZ);
+    ctx->ivec_rebuild_pending = 1U; /* MTPA 表在主循环重建 */
+}
+
+/* 运行时机械参数：速度环前馈、扰动观测器、角度观测器的 Kt/J 前馈一起更新 */
+static void MotorApp_ApplyMotorMech(MotorApp *ctx, float j_kgm2, float b_nms, float tc_nm)
+{
+    ctx->spd_ff.j_kgm2 = j_kgm2;
+    ctx->rls_j_ref_kgm2 = j_kgm2;
+    ctx->spd_ff.b_nms = b_nms;
+    ctx->spd_ff.tc_nm = tc_nm;
+    ctx->spd_dob.j_kgm2 = j_kgm2;
+    ctx->spd_dob.b_nms = b_nms;
+    DistObs_Reset(&ctx->spd_dob, ctx->dbg_omega_pll_rad_s);
+    if (ctx->spd_ato.b_ff != 0.0f)
+    {
+        ctx->spd_ato.b_ff = MOTORAPP_MOTOR_KT_NM_A / j_kgm2;
+    }
+}
+
+/* 速度反馈 PLL（zeta = 1）与角度观测器带宽 */
+static void MotorApp_SetSpeedPllBw(MotorApp *ctx, float wn_rad_s)
+{
+    ctx->spd_pll_kp = 2.0f * wn_rad_s;
+    ctx->spd_pll_ki = wn_rad_s * wn_rad_s;
+    AngleObserver3_SetBandwidth(&ctx->spd_ato, wn_rad_s);
+}
+
+/* 按穿越频率整定速度环：Kp = J*wc/Kt，Ki = Kp*wc/PI_RATIO，PLL wn = PLL_RATIO*wc */
+static void MotorApp_ApplySpeedTune(MotorApp *ctx, float j_kgm2, float bw_hz)
+{
+    const float wc = 6.28318530718f * bw_hz;
+    const float kp = j_kgm2 * wc / MOTORAPP_MOTOR_KT_NM_A;
+    FocSpeedCtrl_SetGains(&ctx->spd_ctrl, kp, kp * wc / MOTORAPP_SPD_TUNE_PI_RATIO);
+    MotorApp_SetSpeedPllBw(ctx, MOTORAPP_SPD_TUNE_PLL_RATIO * wc);
+}
+
+static float MotorApp_FraInject(const MotorApp *ctx, uint8_t point)
+{
+    return (ctx->fra_point == point) ? ctx->fra_inj : 0.0f;
+}
+
+/* 速度环一拍：给定 + 前馈 + 扰动补偿 + PI；观测器用上一拍的实测 Iq 和当前速度反馈 */
+static void MotorApp_SpeedLoopStep(MotorApp *ctx)
+{
+    const float omega_ref = MotorApp_SpeedLoopRef(ctx) + MotorApp_FraInject(ctx, MOTORAPP_FRA_PT_SPD);
+    ctx->fra_omega_ref_rad_s = omega_ref;
+    const float omega_meas = ctx->dbg_omega_pll_rad_s;
+
+    (void)DistObs_Update(&ctx->spd_dob, ctx->dbg_iq_a, omega_meas);
+    ctx->spd_iq_dob_a =
+        (ctx->spd_dob_enable != 0U) ? (ctx->spd_dob.td_hat_nm * (1.0f / MOTORAPP_MOTOR_KT_NM_A)) : 0.0f;
+
+    const float iq_ff = ctx->spd_iq_ff_a + ctx->spd_iq_dob_a;
+    ctx->id_ref_a = 0.0f;
+    ctx->iq_ref_a = FocSpeedCtrl_StepFf(&ctx->spd_ctrl, omega_ref, omega_meas, iq_ff);
+    ctx->spd_iq_pi_a = ctx->iq_ref_a - iq_ff;
+    ctx->spd_omega_err_rad_s = omega_ref - omega_meas;
+}
+
+/* RLS 写入值限制在参考值附近（参考值来自辨识/复位，RLS 写入不改它，避免一步步漂走） */
+static float MotorApp_ClampAround(float x, float ref)
+{
+    const float lo = ref / MOTORAPP_RLS_APPLY_RANGE;
+    const float hi = ref * MOTORAPP_RLS_APPLY_RANGE;
+    return (x < lo) ? lo : ((x > hi) ? hi : x);
+}
+
+/* 中断里按窗口累加，窗口结束时交给主循环（主循环没取走就丢掉本窗口） */
+static void MotorApp_RlsAccumulate(MotorApp *ctx, float uq_v, float id_a, float iq_a, float u_mag_pu)
+{
+    const float omega = ctx->dbg_omega_pll_rad_s;
+    if (ctx->rls_win_tick == 0U)
+    {
+        ctx->rls_acc_uq = 0.0f;
+        ctx->rls_acc_id = 0.0f;
+        ctx->rls_acc_iq = 0.0f;
+        ctx->rls_acc_omega = 0.0f;
+        ctx->rls_iq0_a = iq_a;
+        ctx->rls_omega0_rad_s = omega;
+        ctx->rls_u_mag_max_pu = 0.0f;
+    }
+    ctx->rls_acc_uq += uq_v;
+    ctx->rls_acc_id += id_a;
+    ctx->rls_acc_iq += iq_a;
+    ctx->rls_acc_omega += omega;
+    if (u_mag_pu > ctx->rls_u_mag_max_pu)
+    {
+        ctx->rls_u_mag_max_pu = u_mag_pu;
+    }
+    ctx->rls_win_tick++;
+    if (ctx->rls_win_tick < MOTORAPP_RLS_WIN_TICKS)
+    {
+        return;
+    }
+    ctx->rls_win_tick = 0U;
+    if (ctx->rls_win_ready != 0U)
+    {
+        return;
+    }
+    const float inv_n = 1.0f / (float)MOTORAPP_RLS_WIN_TICKS;
+    ctx->rls_w_uq_v = ctx->rls_acc_uq * inv_n;
+    ctx->rls_w_id_a = ctx->rls_acc_id * inv_n;
+    ctx->rls_w_iq_a = ctx->rls_acc_iq * inv_n;
+    ctx->rls_w_omega_rad_s = ctx->rls_acc_omega * inv_n;
+    ctx->rls_w_diq_a = iq_a - ctx->rls_iq0_a;
+    ctx->rls_w_domega_rad_s = omega - ctx->rls_omega0_rad_s;
+    ctx->rls_w_u_mag_max_pu = ctx->rls_u_mag_max_pu;
+    /* 窗口结果写完再置标志（同 pos_traj_ready） */
+    __DMB();
+    ctx->rls_win_ready = 1U;
+}
+
+/*
+ * 硬件过流门限（主循环）：DAC 码值 = 该相零偏 -/+ I * (R_shunt * G * 4095 / Vref)，
+ * 正电流时采样电压下降（Reconstruct 的 sign = -1），取反通道用减号。零偏换算到 12 位；零偏就绪前不接入 BRK2。
+ * Arm 失败（比较器此刻已在故障电平）保留 pending，下一轮再试。
+ */
+static void MotorApp_OcpService(MotorApp *ctx)
+{
+    if ((ctx->ocp_pending == 0U) || (ctx->i_offset_ready == 0U))
+    {
+        return;
+    }
+    if (ctx->ocp_enable == 0U)
+    {
+        BspOcpComp_Disarm(&ctx->ocp);
+        ctx->ocp_pending = 0U;
+        return;
+    }
+
+    const uint16_t offset_raw[CURRENT_SENSE_PHASE_COUNT] = {
+        ctx->i_u_offset_raw,
+        ctx->i_v_offset_raw,
+        ctx->i_w_offset_raw,
+    };
+    const float counts_per_a =
+        MOTORAPP_CURRENT_SHUNT_OHM * MOTORAPP_CURRENT_AMP_GAIN * MOTORAPP_ADC_MAX_COUNTS / MOTORAPP_ADC_VREF_V;
+    const float d = ctx->ocp_trip_a * counts_per_a;
+    for (uint8_t i = 0U; i < MOTORAPP_OCP_N_CH; ++i)
+    {
+        const float offset = (float)offset_raw[g_motorapp_ocp_phase[i]] / (float)MOTORAPP_ADC_COUNT_SCALE;
+        float code = (g_motorapp_ocp_ch[i].invert != 0U) ? (offset - d) : (offset + d);
+        if (code < 0.0f)
+        {
+            code = 0.0f;
+        }
+        if (code > MOTORAPP_ADC_MAX_COUNTS)
+        {
+            code = MOTORAPP_ADC_MAX_COUNTS;
+        }
+        BspOcpComp_SetThreshold(&ctx->ocp, i, (uint16_t)(code + 0.5f));
+    }
+    if (BspOcpComp_Arm(&ctx->ocp) != 0U)
+    {
+        ctx->ocp_pending = 0U;
+    }
+}
+
+/*
+ * 在线参数跟踪（主循环，每个窗口一次）：
+ * - 电气：q 轴窗口平均 uq = R*iq + Lq*diq/dt + we*Ld*id + Ke*omega，已知的电感项移到左边，RLS 估 [R, Ke]；
+ *   Iq 和速度都够大、窗口内近似稳态、电压不饱和才更新。只有一边有激励时不能调 Update：另一个方向的回归量
+ *   接近 0，P 在该方向按 1/lambda 一直长到 trace 上限，并不会冻结。
+ * - 机械：iq - (B*omega + Tc*sign)/Kt = (J/Kt)*acc + Tl/Kt，|acc| 够大才更新（负载转矩 Tl 作为慢变量一起估）。
+ * rls_apply 打开时写入运行时参数（限制在参考值附近）；ISR 只读单个 float，直接写。
+ */
+static void MotorApp_RlsService(MotorApp *ctx)
+{
+    if (ctx->rls_win_ready == 0U)
+    {
+        return;
+    }
+    __DMB(); /* 看到标志之后再读窗口结果 */
+    const float uq = ctx->rls_w_uq_v;
+    const float id = ctx->rls_w_id_a;
+    const float iq = ctx->rls_w_iq_a;
+    const float omega = ctx->rls_w_omega_rad_s;
+    const float diq = ctx->rls_w_diq_a;
+    const float domega = ctx->rls_w_domega_rad_s;
+    const float u_mag = ctx->rls_w_u_mag_max_pu;
+    __DMB(); /* 读完再交还，ISR 之后才能覆盖 */
+    ctx->rls_win_ready = 0U;
+
+    const float t_win = (float)MOTORAPP_RLS_WIN_TICKS / MOTORAPP_CTRL_HZ;
+    if ((fabsf(iq) >= MOTORAPP_RLS_IQ_MIN_A) && (fabsf(omega) >= MOTORAPP_RLS_OMEGA_MIN_RAD_S) &&
+        (fabsf(diq) <= MOTORAPP_RLS_DIQ_MAX_A) && (u_mag <= MOTORAPP_RLS_U_MAG_MAX_PU))
+    {
+        const float omega_e = ctx->calib.p.pole_pairs * omega;
+        const float y = uq - (ctx->motor_lq_h * diq / t_win) - (omega_e * ctx->motor_ld_h * id);
+        RlsEst2_Update(&ctx->rls_elec, iq, omega / MOTORAPP_RLS_OMEGA_SCALE, y);
+    }
+
+    const float acc = domega / t_win;
+    if ((ctx->spd_loop_enabled != 0U) && (fabsf(acc) >= MOTORAPP_RLS_ACC_MIN_RAD_S2))
+    {
+        const float t_fric = (ctx->spd_ff.b_nms * omega) +
+                             (ctx->spd_ff.tc_nm * SpeedFf_SoftSign(omega, MOTORAPP_SPD_FF_COUL_BAND_RAD_S));
+        const float y = iq - (t_fric / MOTORAPP_MOTOR_KT_NM_A);
+        RlsEst2_Update(&ctx->rls_mech, acc / MOTORAPP_RLS_ACC_SCALE, 1.0f, y);
+    }
+
+    ctx->rls_r_ohm = ctx->rls_elec.theta[0];
+    ctx->rls_ke_v_s = ctx->rls_elec.theta[1] / MOTORAPP_RLS_OMEGA_SCALE;
+    ctx->rls_j_kgm2 = ctx->rls_mech.theta[0] * MOTORAPP_MOTOR_KT_NM_A / MOTORAPP_RLS_ACC_SCALE;
+
+    if (ctx->rls_apply >= 1U)
+    {
+        const float r = MotorApp_ClampAround(ctx->rls_r_ohm, ctx->rls_r_ref_ohm);
+        const float l_h = 0.5f * (ctx->motor_ld_h + ctx->motor_lq_h);
+        /* 保持当前电流环带宽：wc = Kp/L，Ki = R*wc；积分器不清零 */
+        ctx->motor_rs_ohm = r;
+        ctx->i_predict.rs_ohm = r;
+        if (l_h > 0.0f)
+        {
+            FocCurrentCtrl_UpdateGains(&ctx->i_ctrl, ctx->i_ctrl.kp, r * (ctx->i_ctrl.kp / l_h));
+        }
+        const float ke = MotorApp_ClampAround(ctx->rls_ke_v_s, ctx->rls_ke_ref_v_s);
+        if (ke != ctx->motor_ke_v_s)
+        {
+            ctx->motor_ke_v_s = ke;
+            ctx->ivec_rebuild_pending = 1U; /* MTPA 表用的磁链跟着 Ke 变 */
+        }
+    }
+    if (ctx->rls_apply >= 2U)
+    {
+        const float j = MotorApp_ClampAround(ctx->rls_j_kgm2, ctx->rls_j_ref_kgm2);
+        ctx->spd_ff.j_kgm2 = j;
+        ctx->spd_dob.j_kgm2 = j;
+    }
+}
+
+/* 估计器回到当前运行时参数 */
+static void MotorApp_RlsReset(MotorApp *ctx)
+{
+    RlsEst2_Init(&ctx->rls_elec, MOTORAPP_RLS_LAMBDA, 1.0f, 100.0f, ctx->motor_rs_ohm,
+                 ctx->motor_ke_v_s * MOTORAPP_RLS_OMEGA_SCALE);
+    RlsEst2_Init(&ctx->rls_mech, MOTORAPP_RLS_LAMBDA, 1.0f, 100.0f,
+                 ctx->spd_ff.j_kgm2 * MOTORAPP_RLS_ACC_SCALE / MOTORAPP_MOTOR_KT_NM_A, 0.0f);
+    ctx->rls_r_ohm = ctx->motor_rs_ohm;
+    ctx->rls_ke_v_s = ctx->motor_ke_v_s;
+    ctx->rls_j_kgm2 = ctx->spd_ff.j_kgm2;
+}
+
+/*
+ * 位置轨迹规划（主循环）：当前段走完且没有待接手的规划时，从当前位置给定规划到 pos_target_rad，
+ * 结果放进 pos_traj_next，由中断在位置环节拍里接手。
+ */
+static void MotorApp_PosPlanService(MotorApp *ctx)
+{
+    if ((ctx->pos_loop_enabled == 0U) || (ctx->pos_plan_pending == 0U) || (ctx->pos_traj_ready != 0U) ||
+        (ctx->pos_traj.active != 0U))
+    {
+        return;
+    }
+    ctx->pos_plan_pending = 0U;
+    const float base = ctx->pos_ref_rad; /* 轨迹静止，中断不会再改它 */
+    (void)SCurvePos_Plan(&ctx->pos_traj_next, ctx->pos_target_rad - base, MOTORAPP_POS_V_MAX_RAD_S,
+                         MOTORAPP_POS_A_MAX_RAD_S2, MOTORAPP_POS_J_MAX_RAD_S3, MOTORAPP_POS_LOOP_DT_S);
+    ctx->pos_traj_next_base_rad = base;
+    /* 轨迹写完再发布：DMB 同时是编译器屏障，上面的普通写不会被挪到标志之后 */
+    __DMB();
+    ctx->pos_traj_ready = 1U;
 }
 
 static void MotorApp_HandleHostCmd(MotorApp *ctx, const HostCmd *cmd)
@@ -439,14 +1589,86 @@ static void MotorApp_HandleHostCmd(MotorApp *ctx, const HostCmd *cmd)
 
     const uint8_t mt6835_quiet = MotorApp_Mt6835QuietActive();
 
+    /* 死区/R-L 辨识、速度环自整定运行中收到其它控制命令：先中止并停机，再执行新命令 */
+    if (((ctx->dtc_ident.state == DEADTIME_IDENT_RUN) && (cmd->op != 'D') && (cmd->op != 'K')) ||
+        ((ctx->rl_ident.state == RL_IDENT_RUN) && (cmd->op != 'D') && (cmd->op != 'R')) ||
+        ((ctx->spd_ident.state == SPD_IDENT_RUN) && (cmd->op != 'D') && (cmd->op != 'L')))
+    {
+        MotorApp_SafeStop(ctx);
+    }
+
     switch (cmd->op)
     {
     case 'P':
+    {
+        /* P<deg>: 多圈绝对位置点到点移动，P: 保持当前位置（需已完成校准，方向由 elec_dir 决定） */
+        if ((mt6835_quiet != 0U) || (MotorApp_FaultLatched(ctx) != 0U) || (ctx->calib_done == 0U) ||
+            (ctx->enc_mt.valid == 0U))
+        {
+            break;
+        }
+
+        const uint8_t speed_path_running = ((ctx->spd_loop_enabled != 0U) && (ctx->i_loop_enabled != 0U)) ? 1U : 0U;
+        const uint8_t enter_pos_mode = ((ctx->pos_loop_enabled == 0U) || (speed_path_running == 0U)) ? 1U : 0U;
+        if (enter_pos_mode != 0U)
+        {
+            /* 轨迹从当前位置静止起步（运行中切入由位置环把速度拉下来）；先关速度环，状态写完再放开中断 */
+            ctx->spd_loop_enabled = 0U;
+            ctx->pos_origin_count = MotorApp_EncMtCountSnapshot(ctx);
+            ctx->pos_ref_rad = 0.0f;
+            ctx->pos_ref_vel_rad_s = 0.0f;
+            ctx->pos_ref_acc_rad_s2 = 0.0f;
+            ctx->pos_omega_ref_rad_s = ctx->dbg_omega_pll_rad_s;
+            ctx->pos_err_rad = 0.0f;
+            ctx->pos_loop_div_countdown = 0U;
+            SCurvePos_Reset(&ctx->pos_traj);
+            ctx->pos_traj_base_rad = 0.0f;
+            ctx->pos_traj_ready = 0U;
+            ctx->spd_iq_ff_a = 0.0f;
+            FocPosCtrl_Reset(&ctx->pos_ctrl);
+            if (speed_path_running == 0U)
+            {
+                FocSpeedCtrl_Reset(&ctx->spd_ctrl);
+                ctx->id_ref_a = 0.0f;
+                ctx->iq_ref_a = 0.0f;
+            }
+        }
+
         if (cmd->has_value != 0U)
         {
             ctx->target_pos_deg = cmd->value;
+            const int64_t target_user_count =
+                (int64_t)(cmd->value * ((float)MULTITURN_POS_COUNTS_PER_REV / 360.0f));
+            const int64_t origin_user_count = (int64_t)ctx->elec_dir * ctx->pos_origin_count;
+            ctx->pos_target_rad = (float)(target_user_count - origin_user_count) * MULTITURN_POS_RAD_PER_COUNT;
+        }
+        else if (enter_pos_mode != 0U)
+        {
+            ctx->pos_target_rad = 0.0f;
+        }
+        /* 轨迹由主循环规划（MotorApp_PosPlanService），运动中收到的新目标等本段走完再规划 */
+        ctx->pos_plan_pending = 1U;
+
+        ctx->target_vel_rad_s = 0.0f;
+        ctx->spd_loop_div_countdown = 0U;
+        SignalLogSweep_Reset(&ctx->iq_sweep);
+        ctx->iq_sweep_request_pending = 0U;
+        ctx->iq_sweep_div_countdown = 0U;
+        ctx->iq_sweep_a = 0.0f;
+        ctx->vtest_active = 0U;
+        MotorCalib_Abort(&ctx->calib);
+
+        ctx->pos_loop_enabled = 1U;
+        ctx->spd_loop_enabled = 1U;
+        ctx->stream_page = 20U;
+
+        if (ctx->i_loop_enabled == 0U)
+        {
+            ctx->i_loop_enable_pending = 1U;
+            (void)BspTim1Pwm_DisableOutputs(&ctx->pwm);
         }
         break;
+    }
     case 'V':
         if (mt6835_quiet != 0U)
         {
@@ -454,33 +1676,29 @@ static void MotorApp_HandleHostCmd(MotorApp *ctx, const HostCmd *cmd)
         }
         if ((cmd->has_value != 0U) && (fabsf(cmd->value) > MOTORAPP_SCTRL_STOP_EPS))
         {
-            if (ctx->fault_overcurrent != 0U)
+            if (MotorApp_FaultLatched(ctx) != 0U)
             {
-                /* Overcurrent fault latched: ignore enable requests until user stops/clears. */
-                ctx->i_loop_enable_pending = 0U;
-                ctx->i_loop_enabled = 0U;
-                ctx->spd_loop_enabled = 0U;
-                ctx->target_vel_rad_s = 0.0f;
-                ctx->iq_ref_a = 0.0f;
-                FocSpeedCtrl_Reset(&ctx->spd_ctrl);
-                SCurveVel_Reset(&ctx->spd_ref_plan, 0.0f);
-                (void)BspTim1Pwm_DisableOutputs(&ctx->pwm);
+                /* Fault latched / Vbus out of range: ignore enable requests until user stops/clears. */
+                MotorApp_SafeStop(ctx);
                 break;
             }
 
             float omega = cmd->value;
-            if (omega > MOTORAPP_SCTRL_OMEGA_LIMIT_RAD_S)
+            const float omega_limit =
+                (ctx->fw_enable != 0U) ? MOTORAPP_FW_OMEGA_LIMIT_RAD_S : MOTORAPP_SCTRL_OMEGA_LIMIT_RAD_S;
+            if (omega > omega_limit)
             {
-                omega = MOTORAPP_SCTRL_OMEGA_LIMIT_RAD_S;
+                omega = omega_limit;
             }
-            if (omega < -MOTORAPP_SCTRL_OMEGA_LIMIT_RAD_S)
+            if (omega < -omega_limit)
             {
-                omega = -MOTORAPP_SCTRL_OMEGA_LIMIT_RAD_S;
+                omega = -omega_limit;
             }
 
             const uint8_t restart_speed_path = ((ctx->spd_loop_enabled == 0U) || (ctx->i_loop_enabled == 0U)) ? 1U : 0U;
 
             ctx->target_vel_rad_s = omega;
+            ctx->pos_loop_enabled = 0U;
             ctx->spd_loop_div_countdown = 0U;
             SignalLogSweep_Reset(&ctx->iq_sweep);
 
@@ -513,20 +1731,7 @@ static void MotorApp_HandleHostCmd(MotorApp *ctx, const HostCmd *cmd)
         else
         {
             /* Stop speed loop and disable outputs. */
-            ctx->i_loop_enable_pending = 0U;
-            ctx->i_loop_enabled = 0U;
-            ctx->spd_loop_enabled = 0U;
-            ctx->target_vel_rad_s = 0.0f;
-            ctx->iq_ref_a = 0.0f;
-            ctx->spd_loop_div_countdown = 0U;
-            FocSpeedCtrl_Reset(&ctx->spd_ctrl);
-            SCurveVel_Reset(&ctx->spd_ref_plan, 0.0f);
-            SignalLogSweep_Reset(&ctx->iq_sweep);
-            ctx->iq_sweep_request_pending = 0U;
-            ctx->iq_sweep_div_countdown = 0U;
-            ctx->iq_sweep_a = 0.0f;
-            FocCurrentCtrl_Reset(&ctx->i_ctrl);
-            (void)BspTim1Pwm_DisableOutputs(&ctx->pwm);
+            MotorApp_SafeStop(ctx);
         }
         break;
     case 'C':
@@ -538,6 +1743,8 @@ static void MotorApp_HandleHostCmd(MotorApp *ctx, const HostCmd *cmd)
         ctx->calib_request_pending = 1U;
         break;
     case 'D':
+        ctx->fra_tx_idx = 0U; /* 切到 D24 时从头重发频响结果 */
+        ctx->fault_tx_idx = 0U; /* D32 从最新一条开始 */
         if (cmd->has_value != 0U)
         {
             ctx->stream_page = (uint8_t)cmd->value;
@@ -554,18 +1761,10 @@ static void MotorApp_HandleHostCmd(MotorApp *ctx, const HostCmd *cmd)
         }
         if (cmd->has_value != 0U)
         {
-            if (ctx->fault_overcurrent != 0U)
+            if (MotorApp_FaultLatched(ctx) != 0U)
             {
-                /* Overcurrent fault latched: ignore enable requests until user stops/clears. */
-                ctx->i_loop_enable_pending = 0U;
-                ctx->i_loop_enabled = 0U;
-                ctx->spd_loop_enabled = 0U;
-                ctx->target_vel_rad_s = 0.0f;
-                ctx->iq_ref_a = 0.0f;
-                ctx->spd_loop_div_countdown = 0U;
-                FocSpeedCtrl_Reset(&ctx->spd_ctrl);
-                SCurveVel_Reset(&ctx->spd_ref_plan, 0.0f);
-                (void)BspTim1Pwm_DisableOutputs(&ctx->pwm);
+                /* Fault latched / Vbus out of range: ignore enable requests until user stops/clears. */
+                MotorApp_SafeStop(ctx);
                 break;
             }
 
@@ -604,21 +1803,16 @@ static void MotorApp_HandleHostCmd(MotorApp *ctx, const HostCmd *cmd)
         }
         else
         {
-            ctx->i_loop_enable_pending = 0U;
-            ctx->i_loop_enabled = 0U;
-            ctx->spd_loop_enabled = 0U;
-            ctx->target_vel_rad_s = 0.0f;
-            ctx->iq_ref_a = 0.0f;
-            ctx->spd_loop_div_countdown = 0U;
-            FocSpeedCtrl_Reset(&ctx->spd_ctrl);
-            SCurveVel_Reset(&ctx->spd_ref_plan, 0.0f);
-            SignalLogSweep_Reset(&ctx->iq_sweep);
-            ctx->iq_sweep_request_pending = 0U;
-            ctx->iq_sweep_div_countdown = 0U;
-            ctx->iq_sweep_a = 0.0f;
-            FocCurrentCtrl_Reset(&ctx->i_ctrl);
-            ctx->fault_overcurrent = 0U;
-            (void)BspTim1Pwm_DisableOutputs(&ctx->pwm);
+            MotorApp_SafeStop(ctx);
+            /* 硬件过流：MOE 已关，比较器回落后才清 break 标志，否则这两个故障保持锁存 */
+            const uint32_t keep =
+                (BspOcpComp_Rearm(&ctx->ocp) != 0U) ? 0U : (FAULT_MGR_BIT(FAULT_OC_HW) | FAULT_MGR_BIT(FAULT_OC_BKIN));
+            const uint32_t primask = __get_PRIMASK();
+            __disable_irq();
+            FaultMgr_Clear(&ctx->fault, keep);
+            ctx->enc_bad_run = 0U;
+            __set_PRIMASK(primask);
+            ctx->spd_valid = 0U; /* 下一帧有效角度重新初始化 PLL */
         }
         break;
 
@@ -667,25 +1861,9 @@ static void MotorApp_HandleHostCmd(MotorApp *ctx, const HostCmd *cmd)
             uint8_t ack = 0U;
             const uint8_t ok = Mt6835_BurnEeprom(&ctx->encoder, &ack);
 
-            ctx->i_loop_enable_pending = 0U;
-            ctx->i_loop_enabled = 0U;
-            ctx->spd_loop_enabled = 0U;
-            ctx->target_vel_rad_s = 0.0f;
-            ctx->id_ref_a = 0.0f;
-            ctx->iq_ref_a = 0.0f;
-            ctx->spd_loop_div_countdown = 0U;
+            MotorApp_SafeStop(ctx);
             ctx->calib_request = 0U;
             ctx->calib_request_pending = 0U;
-            FocSpeedCtrl_Reset(&ctx->spd_ctrl);
-            SCurveVel_Reset(&ctx->spd_ref_plan, 0.0f);
-            SignalLogSweep_Reset(&ctx->iq_sweep);
-            ctx->iq_sweep_request_pending = 0U;
-            ctx->iq_sweep_div_countdown = 0U;
-            ctx->iq_sweep_a = 0.0f;
-            ctx->vtest_active = 0U;
-            MotorCalib_Abort(&ctx->calib);
-            FocCurrentCtrl_Reset(&ctx->i_ctrl);
-            (void)BspTim1Pwm_DisableOutputs(&ctx->pwm);
 
             ctx->mt6835_reg011 = ack;
             ctx->mt6835_reg011_valid = ok;
@@ -740,33 +1918,352 @@ static void MotorApp_HandleHostCmd(MotorApp *ctx, const HostCmd *cmd)
         /* F1: start log-sweep injection on Iq_cmd, F0: stop */
         ctx->iq_sweep_request = ((cmd->has_value == 0U) || (cmd->value != 0.0f)) ? 1U : 0U;
         ctx->iq_sweep_request_pending = 1U;
+        if (ctx->iq_sweep_request != 0U)
+        {
+            /* 和 H 共用 Iq 注入路径，先停掉步进正弦 */
+            ctx->fra_request_point = MOTORAPP_FRA_PT_NONE;
+            ctx->fra_request_amp = 0.0f;
+            __DMB();
+            ctx->fra_request_pending = 1U;
+        }
         ctx->stream_page = 6U;
         break;
 
-        /* 将转子强拖到U相 */
-    case 'T':
+    case 'H':
+    {
+        /* H<pt>: 步进正弦频率响应分析，pt = 1 Id / 2 Iq / 3 速度给定 / 4 Ud；H0/H: 停止。结果在 D24 逐点发送 */
         if (mt6835_quiet != 0U)
         {
             break;
         }
+        const uint8_t pt = (cmd->has_value != 0U) ? (uint8_t)cmd->value : MOTORAPP_FRA_PT_NONE;
+        float amp = 0.0f;
+        switch (pt)
+        {
+        case MOTORAPP_FRA_PT_ID:
+            amp = MOTORAPP_FRA_AMP_ID_A;
+            break;
+        case MOTORAPP_FRA_PT_IQ:
+            amp = MOTORAPP_FRA_AMP_IQ_A;
+            break;
+        case MOTORAPP_FRA_PT_SPD:
+            amp = MOTORAPP_FRA_AMP_SPD_RAD_S;
+            break;
+        case MOTORAPP_FRA_PT_UD:
+            amp = MOTORAPP_FRA_AMP_UD_V;
+            break;
+        default:
+            break;
+        }
+        /* 注入只在电流环运行时生效；速度给定注入还要求速度环在跑 */
+        if ((amp > 0.0f) &&
+            ((ctx->i_loop_enabled == 0U) || ((pt == MOTORAPP_FRA_PT_SPD) && (ctx->spd_loop_enabled == 0U))))
+        {
+            break;
+        }
+        if (amp > 0.0f)
+        {
+            /* 和 F 扫频共用 Iq 注入路径，先停掉扫频 */
+            ctx->iq_sweep_request = 0U;
+            ctx->iq_sweep_request_pending = 1U;
+        }
+        ctx->fra_request_point = (amp > 0.0f) ? pt : MOTORAPP_FRA_PT_NONE;
+        ctx->fra_request_amp = amp;
+        __DMB();
+        ctx->fra_request_pending = 1U;
+        ctx->fra_tx_idx = 0U;
+        ctx->stream_page = 24U;
+        break;
+    }
+
+    case 'A':
+        /* A0: PLL 速度反馈，A1/A: 三阶观测器；A<bw>（>=10）同时设观测器带宽 rad/s */
+        if ((cmd->has_value != 0U) && (cmd->value >= 10.0f))
+        {
+            AngleObserver3_SetBandwidth(&ctx->spd_ato, cmd->value);
+        }
+        ctx->spd_obs_mode = ((cmd->has_value == 0U) || (cmd->value != 0.0f)) ? 1U : 0U;
+        ctx->stream_page = 19U;
+        break;
+
+    case 'J':
+    case 'B':
+    case 'U':
+        /* 速度环前馈系数：J<uJ>（1e-6 kg*m^2），B<uB>（1e-6 N*m*s/rad），U<mNm>（库仑摩擦）；
+           J/B/U 不带数值：恢复编译期默认值；J0 同时关闭整个前馈，其它 J<v> 打开 */
+        if (cmd->has_value == 0U)
+        {
+            SpeedFf_Init(&ctx->spd_ff, MOTORAPP_MOTOR_J_KGM2, MOTORAPP_MOTOR_B_NMS, MOTORAPP_MOTOR_TC_NM,
+                         MOTORAPP_MOTOR_KT_NM_A, MOTORAPP_SPD_FF_COUL_BAND_RAD_S);
+            ctx->spd_ff_enable = (MOTORAPP_SPD_FF_ENABLE != 0U) ? 1U : 0U;
+        }
+        else if (cmd->op == 'J')
+        {
+            ctx->spd_ff.j_kgm2 = (cmd->value > 0.0f) ? (cmd->value * 1.0e-6f) : 0.0f;
+            ctx->spd_ff_enable = (cmd->value != 0.0f) ? 1U : 0U;
+        }
+        else if (cmd->op == 'B')
+        {
+            ctx->spd_ff.b_nms = (cmd->value > 0.0f) ? (cmd->value * 1.0e-6f) : 0.0f;
+        }
+        else
+        {
+            ctx->spd_ff.tc_nm = (cmd->value > 0.0f) ? (cmd->value * 1.0e-3f) : 0.0f;
+        }
+        ctx->stream_page = 21U;
+        break;
+
+    case 'G':
+        /* G0: 关闭扰动补偿（观测器照常估计），G1/G: 打开；G<bw>（>=10）同时设观测器带宽 rad/s */
+        if ((cmd->has_value != 0U) && (cmd->value >= 10.0f))
+        {
+            DistObs_SetBandwidth(&ctx->spd_dob, cmd->value, ctx->dbg_omega_pll_rad_s);
+        }
+        ctx->spd_dob_enable = ((cmd->has_value == 0U) || (cmd->value != 0.0f)) ? 1U : 0U;
+        ctx->stream_page = 22U;
+        break;
+
+    case 'O':
+        /* O1/O: 按窗口自适应多次采样，O0: 固定单次（MAX_SAMPLES=1 时无效果） */
+        ctx->i_adc_ovs_enable = ((cmd->has_value == 0U) || (cmd->value != 0.0f)) ? 1U : 0U;
+        ctx->stream_page = 13U;
+        break;
+
+    case 'S':
+        /* S1/S: 采样窗口不足时用 dq 预测值，S0: 用原始采样；同时清零三路计数 */
+        ctx->i_predict_enable = ((cmd->has_value == 0U) || (cmd->value != 0.0f)) ? 1U : 0U;
+        ctx->i_sample_meas_count = 0U;
+        ctx->i_sample_pred_count = 0U;
+        ctx->i_sample_raw_count = 0U;
+        ctx->stream_page = 14U;
+        break;
+
+    case 'W':
+        /* W1: 允许过调制到六拍（电压限幅 2/pi），W0/W: 线性区 SVPWM（电压限幅 1/sqrt(3)） */
+        ctx->pwm_ovm_enable = ((cmd->has_value != 0U) && (cmd->value != 0.0f)) ? 1U : 0U;
+        ctx->i_ctrl.v_limit_pu = (ctx->pwm_ovm_enable != 0U) ? SVPWM_OVM_SIX_STEP_PU : MOTORAPP_V_LIMIT_PU;
+        ctx->stream_page = 15U;
+        break;
+
+    case 'Z':
+        /* Z0/Z: 连续 SVPWM；Z1 DPWM0，Z2 DPWM1，Z3 DPWMMAX，Z4 DPWMMIN（|u| 超过切入阈值才生效） */
+        if ((cmd->has_value != 0U) && (cmd->value >= 0.0f) && (cmd->value < (float)SVPWM_ZS_COUNT))
+        {
+            ctx->pwm_zs_mode = (uint8_t)cmd->value;
+        }
+        else
+        {
+            ctx->pwm_zs_mode = (uint8_t)SVPWM_ZS_CONTINUOUS;
+        }
+        ctx->stream_page = 16U;
+        break;
+
+    case 'R':
+        /* R<bw_hz>（>=50）/ R：静止辨识 R/Ld/Lq，成功后按带宽重算电流环 PI；R0：恢复编译期参数 */
         if ((cmd->has_value != 0U) && (cmd->value == 0.0f))
         {
-            ctx->spd_loop_enabled = 0U;
-            ctx->target_vel_rad_s = 0.0f;
-            ctx->spd_loop_div_countdown = 0U;
-            FocSpeedCtrl_Reset(&ctx->spd_ctrl);
-            SCurveVel_Reset(&ctx->spd_ref_plan, 0.0f);
-            SignalLogSweep_Reset(&ctx->iq_sweep);
-            ctx->iq_sweep_request_pending = 0U;
-            ctx->iq_sweep_div_countdown = 0U;
-            ctx->iq_sweep_a = 0.0f;
-            ctx->vtest_active = 0U;
-            ctx->i_loop_enable_pending = 0U;
-            ctx->i_loop_enabled = 0U;
-            ctx->iq_ref_a = 0.0f;
-            FocCurrentCtrl_Reset(&ctx->i_ctrl);
+            MotorApp_ApplyMotorRl(ctx, MOTORAPP_MOTOR_RS_OHM, MOTORAPP_MOTOR_LD_H, MOTORAPP_MOTOR_LQ_H);
+            FocCurrentCtrl_SetGains(&ctx->i_ctrl, MOTORAPP_ICTRL_KP, MOTORAPP_ICTRL_KI);
+            ctx->stream_page = 23U;
+            break;
+        }
+        /* d/q 轴注入要用 theta_e，未校准时电角度零点不对，Ld/Lq 会混在一起 */
+        if ((mt6835_quiet != 0U) || (MotorApp_FaultLatched(ctx) != 0U) || (ctx->i_offset_ready == 0U) ||
+            (ctx->calib_done == 0U) || (ctx->dtc_ident.state == DEADTIME_IDENT_RUN))
+        {
+            break;
+        }
+        ctx->rl_tune_bw_hz = ((cmd->has_value != 0U) && (cmd->value >= 50.0f)) ? cmd->value : MOTORAPP_ICTRL_BW_HZ;
+        ctx->pos_loop_enabled = 0U;
+        ctx->spd_loop_enabled = 0U;
+        ctx->target_vel_rad_s = 0.0f;
+        ctx->spd_loop_div_countdown = 0U;
+        FocSpeedCtrl_Reset(&ctx->spd_ctrl);
+        SCurveVel_Reset(&ctx->spd_ref_plan, 0.0f);
+        SignalLogSweep_Reset(&ctx->iq_sweep);
+        ctx->iq_sweep_request_pending = 0U;
+        ctx->iq_sweep_div_countdown = 0U;
+        ctx->iq_sweep_a = 0.0f;
+        ctx->vtest_active = 0U;
+        ctx->i_loop_enable_pending = 0U;
+        ctx->i_loop_enabled = 0U;
+        ctx->iq_ref_a = 0.0f;
+        FocCurrentCtrl_Reset(&ctx->i_ctrl);
+        RlIdent_Start(&ctx->rl_ident, MOTORAPP_RL_IDENT_I1_A, MOTORAPP_RL_IDENT_I2_A, MOTORAPP_RL_IDENT_DI_A,
+                      1.0f / MOTORAPP_CTRL_HZ, (uint32_t)(MOTORAPP_CTRL_HZ * MOTORAPP_RL_IDENT_SETTLE_S),
+                      (uint32_t)(MOTORAPP_CTRL_HZ * MOTORAPP_RL_IDENT_AVG_S),
+                      (uint32_t)(MOTORAPP_CTRL_HZ * MOTORAPP_RL_IDENT_INJ_S));
+        if (MotorApp_TryEnableOutputs(ctx, 0U) == 0U)
+        {
+            MotorApp_SafeStop(ctx);
+        }
+        ctx->stream_page = 23U;
+        break;
+
+    case 'L':
+        /* L<bw_hz>（>=1）/ L：加减速辨识 J/B/Tc，成功后按穿越频率（默认 40Hz）重算速度 PI 和 PLL；L0：恢复编译期参数 */
+        if ((cmd->has_value != 0U) && (cmd->value == 0.0f))
+        {
+            MotorApp_ApplyMotorMech(ctx, MOTORAPP_MOTOR_J_KGM2, MOTORAPP_MOTOR_B_NMS, MOTORAPP_MOTOR_TC_NM);
+            FocSpeedCtrl_SetGains(&ctx->spd_ctrl, MOTORAPP_SPDCTRL_KP, MOTORAPP_SPDCTRL_KI);
+            ctx->spd_pll_kp = MOTORAPP_SPD_PLL_KP;
+            ctx->spd_pll_ki = MOTORAPP_SPD_PLL_KI;
+            AngleObserver3_SetBandwidth(&ctx->spd_ato, MOTORAPP_SPD_ATO_BW_RAD_S);
+            ctx->stream_page = 25U;
+            break;
+        }
+        if ((mt6835_quiet != 0U) || (MotorApp_FaultLatched(ctx) != 0U) || (ctx->calib_done == 0U) ||
+            (ctx->i_offset_ready == 0U) || (ctx->dtc_ident.state == DEADTIME_IDENT_RUN) ||
+            (ctx->rl_ident.state == RL_IDENT_RUN) || (ctx->spd_ident.state == SPD_IDENT_RUN))
+        {
+            break;
+        }
+        ctx->spd_tune_bw_hz = ((cmd->has_value != 0U) && (cmd->value >= 1.0f)) ? cmd->value : MOTORAPP_SPD_TUNE_BW_HZ;
+        ctx->pos_loop_enabled = 0U;
+        ctx->spd_loop_enabled = 0U;
+        ctx->target_vel_rad_s = 0.0f;
+        ctx->spd_loop_div_countdown = 0U;
+        FocSpeedCtrl_Reset(&ctx->spd_ctrl);
+        SCurveVel_Reset(&ctx->spd_ref_plan, 0.0f);
+        SignalLogSweep_Reset(&ctx->iq_sweep);
+        ctx->iq_sweep_request_pending = 0U;
+        ctx->iq_sweep_div_countdown = 0U;
+        ctx->iq_sweep_a = 0.0f;
+        ctx->fra_request_point = MOTORAPP_FRA_PT_NONE;
+        __DMB();
+        ctx->fra_request_pending = 1U;
+        ctx->vtest_active = 0U;
+        MotorCalib_Abort(&ctx->calib);
+        ctx->id_ref_a = 0.0f;
+        ctx->iq_ref_a = 0.0f;
+        ctx->spd_ident_div_countdown = 0U;
+        SpeedIdent_Start(&ctx->spd_ident, MOTORAPP_SPD_ID_I_A, MOTORAPP_SPD_ID_OMEGA_RAD_S, MOTORAPP_MOTOR_KT_NM_A,
+                         ((float)MOTORAPP_SPEED_LOOP_DIV) * (1.0f / MOTORAPP_CTRL_HZ),
+                         (uint32_t)(MOTORAPP_SPD_ID_COAST_S * MOTORAPP_CTRL_HZ / (float)MOTORAPP_SPEED_LOOP_DIV),
+                         (uint32_t)(MOTORAPP_SPD_ID_SEG_MAX_S * MOTORAPP_CTRL_HZ / (float)MOTORAPP_SPEED_LOOP_DIV),
+                         (uint32_t)(MOTORAPP_SPD_ID_WIN_S * MOTORAPP_CTRL_HZ / (float)MOTORAPP_SPEED_LOOP_DIV),
+                         (uint32_t)(MOTORAPP_SPD_ID_SKIP_S * MOTORAPP_CTRL_HZ / (float)MOTORAPP_SPEED_LOOP_DIV));
+        if (ctx->i_loop_enabled == 0U)
+        {
+            ctx->i_loop_enable_pending = 1U;
             (void)BspTim1Pwm_DisableOutputs(&ctx->pwm);
         }
+        ctx->stream_page = 25U;
+        break;
+
+    case 'Q':
+        /* Q<A>：硬件过流门限（不低于 I_LIMIT），Q0：断开比较器，Q：默认门限；主循环写 DAC 并接入 BRK2 */
+        if (cmd->has_value == 0U)
+        {
+            ctx->ocp_trip_a = MOTORAPP_OCP_TRIP_A;
+            ctx->ocp_enable = 1U;
+        }
+        else if (cmd->value <= 0.0f)
+        {
+            ctx->ocp_enable = 0U;
+        }
+        else
+        {
+            ctx->ocp_trip_a = (cmd->value < ctx->i_limit_a) ? ctx->i_limit_a : cmd->value;
+            ctx->ocp_enable = 1U;
+        }
+        ctx->ocp_pending = 1U;
+        ctx->stream_page = 30U;
+        break;
+
+    case 'Y':
+        /* Y0 / Y：电流圆 D 优先（弱磁 Id 先满足），Y1：Q 优先（转矩先满足，弱磁只用剩余部分） */
+        ctx->ivec.prio = ((cmd->has_value != 0U) && (cmd->value != 0.0f)) ? CURRENT_VEC_PRIO_Q : CURRENT_VEC_PRIO_D;
+        ctx->stream_page = 29U;
+        break;
+
+    case 'N':
+        /* N1 / N：速度环弱磁打开（速度指令上限提到 MOTORAPP_FW_OMEGA_LIMIT_RAD_S），N0：关闭（Id 由中断里积分回 0） */
+        ctx->fw_enable = ((cmd->has_value == 0U) || (cmd->value != 0.0f)) ? 1U : 0U;
+        ctx->stream_page = 28U;
+        break;
+
+    case 'X':
+        /* X0：关闭 dq 交叉耦合前馈，X1 / X：按电流给定，X2：按实测电流 */
+        if (cmd->has_value == 0U)
+        {
+            ctx->dq_decouple_mode = 1U;
+        }
+        else
+        {
+            ctx->dq_decouple_mode = (cmd->value >= 2.0f) ? 2U : ((cmd->value >= 1.0f) ? 1U : 0U);
+        }
+        ctx->stream_page = 27U;
+        break;
+
+    case 'E':
+        /* E0：只估计，E1：R/Ke 写入反电动势前馈和电流环 Ki，E2：再加 J；E：估计器复位到当前参数 */
+        if (cmd->has_value == 0U)
+        {
+            MotorApp_RlsReset(ctx);
+        }
+        else
+        {
+            ctx->rls_apply = (cmd->value >= 2.0f) ? 2U : ((cmd->value >= 1.0f) ? 1U : 0U);
+        }
+        ctx->stream_page = 26U;
+        break;
+
+    case 'K':
+        /* K<duty>: 设置死区补偿幅值（K0 关闭）；K: 静止 Id 扫描自动辨识，完成后自动写入幅值 */
+        if (cmd->has_value != 0U)
+        {
+            float duty = cmd->value;
+            if (duty < 0.0f)
+            {
+                duty = 0.0f;
+            }
+            if (duty > MOTORAPP_DTC_DUTY_MAX)
+            {
+                duty = MOTORAPP_DTC_DUTY_MAX;
+            }
+            ctx->dtc.duty_comp = duty;
+            ctx->stream_page = 17U;
+            break;
+        }
+        if ((mt6835_quiet != 0U) || (MotorApp_FaultLatched(ctx) != 0U) || (ctx->i_offset_ready == 0U))
+        {
+            break;
+        }
+        ctx->spd_loop_enabled = 0U;
+        ctx->target_vel_rad_s = 0.0f;
+        ctx->spd_loop_div_countdown = 0U;
+        FocSpeedCtrl_Reset(&ctx->spd_ctrl);
+        SCurveVel_Reset(&ctx->spd_ref_plan, 0.0f);
+        SignalLogSweep_Reset(&ctx->iq_sweep);
+        ctx->iq_sweep_request_pending = 0U;
+        ctx->iq_sweep_div_countdown = 0U;
+        ctx->iq_sweep_a = 0.0f;
+        ctx->vtest_active = 0U;
+        ctx->i_loop_enable_pending = 0U;
+        ctx->i_loop_enabled = 0U;
+        ctx->iq_ref_a = 0.0f;
+        FocCurrentCtrl_Reset(&ctx->i_ctrl);
+        DeadTimeIdent_Start(&ctx->dtc_ident, MOTORAPP_DTC_IDENT_I_MAX_A, (uint16_t)MOTORAPP_DTC_IDENT_STEPS,
+                            (uint32_t)(MOTORAPP_CTRL_HZ * MOTORAPP_DTC_IDENT_SETTLE_S),
+                            (uint32_t)(MOTORAPP_CTRL_HZ * MOTORAPP_DTC_IDENT_AVG_S));
+        if (MotorApp_TryEnableOutputs(ctx, 0U) == 0U)
+        {
+            MotorApp_SafeStop(ctx);
+        }
+        ctx->stream_page = 17U;
+        break;
+
+        /* 将转子强拖到U相 */
+    case 'T':
+        if (mt6835_quiet != 0U)
+        {
+            break;
+        }
+        if (((cmd->has_value != 0U) && (cmd->value == 0.0f)) || (MotorApp_FaultLatched(ctx) != 0U))
+        {
+            MotorApp_SafeStop(ctx);
+        }
         else
         {
             ctx->spd_loop_enabled = 0U;
@@ -796,7 +2293,10 @@ static void MotorApp_HandleHostCmd(MotorApp *ctx, const HostCmd *cmd)
             ctx->i_loop_enabled = 0U;
             ctx->iq_ref_a = 0.0f;
             FocCurrentCtrl_Reset(&ctx->i_ctrl);
-            (void)BspTim1Pwm_EnableOutputs(&ctx->pwm);
+            if (MotorApp_TryEnableOutputs(ctx, 0U) == 0U)
+            {
+                MotorApp_SafeStop(ctx);
+            }
         }
         break;
     default:
@@ -804,6 +2304,30 @@ static void MotorApp_HandleHostCmd(MotorApp *ctx, const HostCmd *cmd)
     }
 }
 
+/*
+ * 控制中断出口的截止时间检查：TIM1 中心对齐，一个 PWM 周期 = 2*ARR 个计数（与 CPU 同为 170MHz），
+ * 按计数方向把 CNT 展开成周期内相位，减去 ADC 触发点（上计数 MOTORAPP_ADC_TRIG_CCR）即出口距本次触发的相位。
+ */
+static void MotorApp_IsrTimingExit(MotorApp *ctx)
+{
+    const TIM_TypeDef *tim = ctx->pwm.htim->Instance;
+    const uint32_t cnt = tim->CNT;
+    const uint32_t cyc = DWT->CYCCNT;
+    const uint32_t p = ctx->isr_timing.period_cyc;
+    const uint32_t pos = ((tim->CR1 & TIM_CR1_DIR) != 0U) ? (p - cnt) : cnt;
+    const uint32_t el = (pos >= MOTORAPP_ADC_TRIG_CCR) ? (pos - MOTORAPP_ADC_TRIG_CCR)
+                                                       : ((pos + p) - MOTORAPP_ADC_TRIG_CCR);
+    if (IsrTiming_Exit(&ctx->isr_timing, el, cyc, BspAdcInjPair_PollOverrun(&ctx->adc_inj)) != 0U)
+    {
+        MotorApp_RaiseFault(ctx, FAULT_ISR_OVERRUN,
+                            (float)(ctx->isr_timing.overrun_count + ctx->isr_timing.miss_count));
+    }
+    else
+    {
+        MotorApp_ReleaseFault(ctx, FAULT_ISR_OVERRUN);
+    }
+}
+
 /* 控制 tick（约 20kHz）入口：由 ADC injected 转换完成回调触发。
  * - 采样电流（带 U/V/W offset 两阶段校准）
  * - 推进校准状态机（C1）/ 电流环（I）/ 电压测试（T）
@@ -818,12 +2342,15 @@ static void MotorApp_OnAdcPair(void *user, uint16_t adc1, uint16_t adc2)
     {
         return;
     }
+    const uint8_t sampled_valid = ctx->i_pair_valid_active;
 
     /* ISR profiling pulse on PC8 (S_Pin): high at entry, low at exit */
     S_GPIO_Port->BSRR = (uint32_t)S_Pin;
+    (void)IsrTiming_Entry(&ctx->isr_timing, DWT->CYCCNT);
 
     ctx->adc1_raw = adc1;
     ctx->adc2_raw = adc2;
+    ctx->dbg_i_adc_samples = ctx->i_adc_samples;
 
     /* 心跳监控（Telemetry / Profiling）变量 */
     ctx->adc_isr_count++;
@@ -846,41 +2373,62 @@ static void MotorApp_OnAdcPair(void *user, uint16_t adc1, uint16_t adc2)
 #endif
 #endif
 
-    /* Pop encoder sample completed by SPI DMA ISR (pipeline: 1 tick latency) */
-    uint32_t raw21 = 0U;
-    if (BspMt6835Dma_PopRaw21(&ctx->enc_dma, &raw21) != 0U)
+    /* Pop encoder sample completed by SPI DMA ISR (timer trigger: same tick; otherwise pipeline: 1 tick latency) */
     {
-        ctx->raw21 = raw21;
-        ctx->raw21_corr = Mt6835AngleCorr_ApplyRaw21(raw21);
-        ctx->pos_mech_rad = Mt6835_Raw21ToRad(ctx->raw21_corr);
-
-        const float theta = ctx->pos_mech_rad;
-        const float dt = ((float)MOTORAPP_ENCODER_READ_DIV) * (1.0f / MOTORAPP_CTRL_HZ);
-        /* 第一次启动，速度计算初始化 */
-        if (ctx->spd_valid == 0U)
+        uint8_t frame[BSP_MT6835_DMA_FRAME_LEN];
+        uint32_t raw21 = 0U;
+        uint8_t status = 0U;
+        uint8_t enc_ok = 0U;
+        uint8_t enc_bad = 1U;
+        FaultCode enc_fault = FAULT_ENC_CRC;
+        if (BspMt6835Dma_PopFrame(&ctx->enc_dma, frame) != 0U)
+        {
+            if (Mt6835_DecodeAngleFrame(frame, &raw21, &status) == 0U)
+            {
+                ctx->enc_crc_err_count++;
+            }
+            else if ((status & (uint8_t)MOTORAPP_ENC_STATUS_REJECT_MASK) != 0U)
+            {
+                ctx->enc_status = status;
+                ctx->enc_status_rej_count++;
+            }
+            else
+            {
+                ctx->enc_status = status;
+                enc_ok = 1U;
+                enc_bad = 0U;
+            }
+        }
+        else if (ctx->enc_frame_expected != 0U)
         {
-            ctx->spd_valid = 1U;
-            ctx->spd_theta_prev_rad = theta;
-            ctx->spd_omega_diff_rad_s = 0.0f;
-            ctx->spd_pll_theta_hat_rad = theta;
-            ctx->spd_pll_omega_int_rad_s = 0.0f;
-            ctx->spd_omega_pll_rad_s = 0.0f;
+            ctx->enc_missing_count++;
+            enc_fault = FAULT_ENC_TIMEOUT;
         }
         else
         {
-            const float dtheta = MotorApp_WrapPi(theta - ctx->spd_theta_prev_rad);
-            ctx->spd_theta_prev_rad = theta;
-            ctx->spd_omega_diff_rad_s = dtheta / dt;
-
-            const float e = MotorApp_WrapPi(theta - ctx->spd_pll_theta_hat_rad);
-            ctx->spd_pll_omega_int_rad_s += (MOTORAPP_SPD_PLL_KI * e * dt);
-            ctx->spd_omega_pll_rad_s = ctx->spd_pll_omega_int_rad_s + (MOTORAPP_SPD_PLL_KP * e);
-            ctx->spd_pll_theta_hat_rad = MotorApp_Wrap2Pi(ctx->spd_pll_theta_hat_rad + (ctx->spd_omega_pll_rad_s * dt));
+            /* 本拍没有发起读取（分频/寄存器操作冻结），不算坏帧 */
+            enc_bad = 0U;
         }
 
-        /* 统一符号：让 Iq>0 时 speed 为正（即使编码器角度递减，elec_dir=-1） */
-        ctx->dbg_omega_diff_rad_s = (float)ctx->elec_dir * ctx->spd_omega_diff_rad_s;
-        ctx->dbg_omega_pll_rad_s = (float)ctx->elec_dir * ctx->spd_omega_pll_rad_s;
+        if (enc_ok != 0U)
+        {
+            ctx->enc_bad_run = 0U;
+            MotorApp_EncoderAccept(ctx, raw21);
+        }
+        else if (enc_bad != 0U)
+        {
+            if (ctx->enc_bad_run < 0xFFFFU)
+            {
+                ctx->enc_bad_run++;
+            }
+            MotorApp_EncoderExtrapolate(ctx);
+            if (ctx->enc_bad_run > MOTORAPP_ENC_BAD_MAX_TICKS)
+            {
+                /* 以越限这一拍的坏帧类型记故障码 */
+                MotorApp_RaiseFault(ctx, enc_fault, (float)ctx->enc_bad_run);
+            }
+        }
+        ctx->enc_frame_expected = 0U;
     }
 
     /* Start next encoder DMA transaction (frequency divider) */
@@ -903,7 +2451,8 @@ static void MotorApp_OnAdcPair(void *user, uint16_t adc1, uint16_t adc2)
     }
     else if (ctx->enc_div_countdown == 0U)
     {
-        (void)BspMt6835Dma_TryStart(&ctx->enc_dma);
+        ctx->enc_frame_expected = (ctx->enc_tim_trigger != 0U) ? BspMt6835Dma_Arm(&ctx->enc_dma)
+                                                                : BspMt6835Dma_TryStart(&ctx->enc_dma);
         ctx->enc_div_countdown = (uint16_t)(MOTORAPP_ENCODER_READ_DIV - 1U);
     }
     else
@@ -939,7 +2488,7 @@ static void MotorApp_OnAdcPair(void *user, uint16_t adc1, uint16_t adc2)
                 ctx->i_offset_stage = 1U;
                 CurrentSenseOffset2_Init(&ctx->i_ab_offset, MOTORAPP_CURRENT_OFFSET_SAMPLES);
                 /* Sample A+C to calibrate C offset. */
-                MotorApp_ProgramCurrentPair(ctx, CURRENT_SENSE_PAIR_AC);
+                MotorApp_ProgramCurrentPair(ctx, CURRENT_SENSE_PAIR_AC, (uint8_t)MOTORAPP_ADC_OVS_MAX_SAMPLES);
             }
             else if (ctx->i_offset_stage == 1U)
             {
@@ -948,7 +2497,7 @@ static void MotorApp_OnAdcPair(void *user, uint16_t adc1, uint16_t adc2)
                 ctx->i_offset_stage = 2U;
                 ctx->i_offset_ready = 1U;
                 /* Back to default A+B sampling before dynamic selection takes over. */
-                MotorApp_ProgramCurrentPair(ctx, CURRENT_SENSE_PAIR_AB);
+                MotorApp_ProgramCurrentPair(ctx, CURRENT_SENSE_PAIR_AB, 1U);
             }
         }
     }
@@ -963,9 +2512,41 @@ static void MotorApp_OnAdcPair(void *user, uint16_t adc1, uint16_t adc2)
             ctx->i_w_offset_raw,
         };
         ctx->dbg_i_pair_active = (uint8_t)sampled_pair;
-        CurrentSense3Shunt_Reconstruct(sampled_pair, adc1, adc2, offset_raw, MOTORAPP_ADC_MAX_COUNTS, MOTORAPP_ADC_VREF_V,
+        CurrentSense3Shunt_Reconstruct(sampled_pair, adc1, adc2, offset_raw,
+                                       MOTORAPP_ADC_MAX_COUNTS * (float)MOTORAPP_ADC_COUNT_SCALE, MOTORAPP_ADC_VREF_V,
                                        MOTORAPP_CURRENT_SHUNT_OHM, MOTORAPP_CURRENT_AMP_GAIN, -1.0f, &ctx->ia_a, &ctx->ib_a,
                                        &ctx->ic_a);
+
+        /* 采样有效性统计 + 窗口不足时的预测替代（只在电流环运行时有上一拍 dq 状态） */
+        uint8_t sample_raw = 0U;
+        if (sampled_valid != 0U)
+        {
+            ctx->i_sample_meas_count++;
+            CurrentPredictDq_MarkMeasured(&ctx->i_predict);
+        }
+        else if ((ctx->i_predict_enable != 0U) && (MotorApp_PredictPhaseCurrents(ctx) != 0U))
+        {
+            ctx->i_sample_pred_count++;
+        }
+        else
+        {
+            ctx->i_sample_raw_count++;
+            sample_raw = ctx->i_loop_enabled;
+        }
+
+        if (sample_raw == 0U)
+        {
+            ctx->i_sample_bad_run = 0U;
+            MotorApp_ReleaseFault(ctx, FAULT_SAMPLE_INVALID);
+        }
+        else if (ctx->i_sample_bad_run < 0xFFFFU)
+        {
+            ctx->i_sample_bad_run++;
+            if (ctx->i_sample_bad_run > MOTORAPP_SAMPLE_BAD_MAX_TICKS)
+            {
+                MotorApp_RaiseFault(ctx, FAULT_SAMPLE_INVALID, (float)ctx->i_sample_bad_run);
+            }
+        }
     }
     else
     {
@@ -975,36 +2556,37 @@ static void MotorApp_OnAdcPair(void *user, uint16_t adc1, uint16_t adc2)
         ctx->ic_a = 0.0f;
     }
 
+    /* 硬件过流：比较器/BKIN 已经在硬件上清了 MOE，这里只把 break 标志转成故障锁存并停掉环路 */
+    if (ctx->pwm.outputs_enabled != 0U)
+    {
+        const uint8_t hw_trip = BspOcpComp_PollTrip(&ctx->ocp);
+        if ((hw_trip & BSP_OCP_COMP_TRIP_BRK2) != 0U)
+        {
+            MotorApp_RaiseFault(ctx, FAULT_OC_HW, ctx->ocp_trip_a);
+        }
+        if ((hw_trip & BSP_OCP_COMP_TRIP_BRK) != 0U)
+        {
+            MotorApp_RaiseFault(ctx, FAULT_OC_BKIN, 0.0f);
+        }
+    }
+
     /* Minimal software overcurrent trip (latched) */
-    if ((ctx->fault_overcurrent == 0U) && (ctx->i_offset_ready != 0U) && (ctx->pwm.outputs_enabled != 0U))
+    if ((ctx->i_offset_ready != 0U) && (ctx->pwm.outputs_enabled != 0U))
     {
         const float ia = fabsf(ctx->ia_a);
         const float ib = fabsf(ctx->ib_a);
         const float ic = fabsf(ctx->ic_a);
-        if ((ia > ctx->i_trip_a) || (ib > ctx->i_trip_a) || (ic > ctx->i_trip_a))
-        {
-            ctx->fault_overcurrent = 1U;
-            ctx->i_loop_enable_pending = 0U;
-            ctx->i_loop_enabled = 0U;
-            ctx->spd_loop_enabled = 0U;
-            ctx->target_vel_rad_s = 0.0f;
-            ctx->iq_ref_a = 0.0f;
-            ctx->spd_loop_div_countdown = 0U;
-            FocSpeedCtrl_Reset(&ctx->spd_ctrl);
-            SCurveVel_Reset(&ctx->spd_ref_plan, 0.0f);
-            SignalLogSweep_Reset(&ctx->iq_sweep);
-            ctx->iq_sweep_request_pending = 0U;
-            ctx->iq_sweep_div_countdown = 0U;
-            ctx->iq_sweep_a = 0.0f;
-            ctx->vtest_active = 0U;
-            FocCurrentCtrl_Reset(&ctx->i_ctrl);
-            MotorCalib_Abort(&ctx->calib);
-            (void)BspTim1Pwm_DisableOutputs(&ctx->pwm);
+        const float i_max = (ia > ib) ? ((ia > ic) ? ia : ic) : ((ib > ic) ? ib : ic);
+        if (i_max > ctx->i_trip_a)
+        {
+            MotorApp_RaiseFault(ctx, FAULT_OC_SW, i_max);
         }
     }
 
+    MotorApp_ThermalTick(ctx);
+
     /* 锁存错误标志，直接跳到函数末尾，退出本次中断*/
-    if (ctx->fault_overcurrent != 0U)
+    if (MotorApp_FaultLatched(ctx) != 0U)
     {
         goto isr_exit;
     }
@@ -1060,22 +2642,70 @@ static void MotorApp_OnAdcPair(void *user, uint16_t adc1, uint16_t adc2)
             }
         }
 
+        /* 频率响应分析：启停也放在中断里，注入量本拍各注入点共用 */
+        if (ctx->fra_request_pending != 0U)
+        {
+            __DMB();
+            ctx->fra_request_pending = 0U;
+            ctx->fra_point = ctx->fra_request_point;
+            if (ctx->fra_point != MOTORAPP_FRA_PT_NONE)
+            {
+                /* omega_ref 只在速度环节拍更新，H3 的频点上限按速度环频率算 */
+                const float f_end_hz =
+                    (ctx->fra_point == MOTORAPP_FRA_PT_SPD) ? MOTORAPP_FRA_F_END_SPD_HZ : MOTORAPP_FRA_F_END_HZ;
+                FreqResp_Start(&ctx->fra, ctx->fra_request_amp, MOTORAPP_FRA_F_START_HZ, f_end_hz,
+                               (uint16_t)MOTORAPP_FRA_POINTS, (uint16_t)MOTORAPP_FRA_SETTLE_CYCLES,
+                               (uint16_t)MOTORAPP_FRA_MEAS_CYCLES, MOTORAPP_FRA_MIN_SETTLE_S, MOTORAPP_FRA_MIN_MEAS_S,
+                               1.0f / MOTORAPP_CTRL_HZ);
+            }
+            else
+            {
+                FreqResp_Stop(&ctx->fra);
+            }
+        }
+        if (ctx->fra.active == 0U)
+        {
+            ctx->fra_point = MOTORAPP_FRA_PT_NONE;
+        }
+        ctx->fra_inj = FreqResp_Inject(&ctx->fra);
+
+        /* 速度环自整定：按速度环节拍给 Iq（速度环此时关闭）；结束后写入参数并停电流环 */
+        if (ctx->spd_ident.state == SPD_IDENT_RUN)
+        {
+            if (ctx->spd_ident_div_countdown == 0U)
+            {
+                ctx->iq_ref_a = SpeedIdent_Tick(&ctx->spd_ident, ctx->dbg_omega_pll_rad_s);
+                ctx->spd_ident_div_countdown =
+                    (uint16_t)((MOTORAPP_SPEED_LOOP_DIV > 0U) ? (MOTORAPP_SPEED_LOOP_DIV - 1U) : 0U);
+            }
+            else
+            {
+                ctx->spd_ident_div_countdown--;
+            }
+            if (ctx->spd_ident.state != SPD_IDENT_RUN)
+            {
+                if (ctx->spd_ident.state == SPD_IDENT_DONE)
+                {
+                    MotorApp_ApplyMotorMech(ctx, ctx->spd_ident.j_kgm2,
+                                            (ctx->spd_ident.b_nms > 0.0f) ? ctx->spd_ident.b_nms : 0.0f,
+                                            (ctx->spd_ident.tc_nm > 0.0f) ? ctx->spd_ident.tc_nm : 0.0f);
+                    MotorApp_ApplySpeedTune(ctx, ctx->spd_ident.j_kgm2, ctx->spd_tune_bw_hz);
+                }
+                ctx->iq_ref_a = 0.0f;
+                ctx->i_loop_enabled = 0U;
+                FocCurrentCtrl_Reset(&ctx->i_ctrl);
+                (void)BspTim1Pwm_DisableOutputs(&ctx->pwm);
+                goto isr_exit;
+            }
+        }
+
         /* Speed loop (outer): update Iq_ref at lower rate, current loop still runs at 20kHz */
         if (ctx->spd_loop_enabled != 0U)
         {
 #if (MOTORAPP_SPEED_LOOP_DIV > 0U)
             if (ctx->spd_loop_div_countdown == 0U)
             {
-                float omega_ref = ctx->target_vel_rad_s;
-#if (MOTORAPP_SPD_REF_S_CURVE_ENABLE != 0U)
-                omega_ref = SCurveVel_Step(&ctx->spd_ref_plan, omega_ref);
-#else
-                /* 同步实际速度至S-Curve规划器内部状态，确保闭环瞬间速度平滑衔接 */
-                SCurveVel_Reset(&ctx->spd_ref_plan, omega_ref);
-#endif
-                const float omega_meas = ctx->dbg_omega_pll_rad_s;
-                ctx->id_ref_a = 0.0f;
-                ctx->iq_ref_a = FocSpeedCtrl_Step(&ctx->spd_ctrl, omega_ref, omega_meas);
+                MotorApp_SpeedLoopStep(ctx);
                 ctx->spd_loop_div_countdown = (uint16_t)(MOTORAPP_SPEED_LOOP_DIV - 1U);
             }
             else
@@ -1083,21 +2713,15 @@ static void MotorApp_OnAdcPair(void *user, uint16_t adc1, uint16_t adc2)
                 ctx->spd_loop_div_countdown--;
             }
 #else
-            float omega_ref = ctx->target_vel_rad_s;
-#if (MOTORAPP_SPD_REF_S_CURVE_ENABLE != 0U)
-            omega_ref = SCurveVel_Step(&ctx->spd_ref_plan, omega_ref);
-#else
-            SCurveVel_Reset(&ctx->spd_ref_plan, omega_ref);
-#endif
-            const float omega_meas = ctx->dbg_omega_pll_rad_s;
-            ctx->id_ref_a = 0.0f;
-            ctx->iq_ref_a = FocSpeedCtrl_Step(&ctx->spd_ctrl, omega_ref, omega_meas);
+            MotorApp_SpeedLoopStep(ctx);
 #endif
         }
         else
         {
             ctx->spd_loop_div_countdown = 0U;
             SCurveVel_Reset(&ctx->spd_ref_plan, ctx->target_vel_rad_s);
+            DistObs_Reset(&ctx->spd_dob, ctx->dbg_omega_pll_rad_s);
+            ctx->spd_iq_dob_a = 0.0f;
         }
 
         /* Iq log-sweep injection (for system identification): Iq_cmd = Iq_base + sweep */
@@ -1123,7 +2747,22 @@ static void MotorApp_OnAdcPair(void *user, uint16_t adc1, uint16_t adc2)
             ctx->iq_sweep_a = 0.0f;
         }
 
-        float iq_cmd_a = ctx->iq_ref_a + ctx->iq_sweep_a;
+        /* 弱磁：用上一拍的电压幅值；关闭或速度环不跑时积分回 0，不突跳 */
+        if (ctx->spd_loop_enabled != 0U)
+        {
+            /* 关闭时按饱和下探同样的斜率回 0：误差取 +(1 - u_ratio) * v_limit */
+            const float u_mag_pu = (ctx->fw_enable != 0U)
+                                       ? ctx->dbg_u_mag_pu
+                                       : (((2.0f * ctx->fw.u_ratio) - 1.0f) * ctx->i_ctrl.v_limit_pu);
+            (void)FieldWeaken_Step(&ctx->fw, u_mag_pu, ctx->i_ctrl.v_limit_pu);
+        }
+        else
+        {
+            FieldWeaken_Reset(&ctx->fw);
+        }
+
+        /* 转矩需求（等效 Iq） */
+        float iq_dem_a = ctx->iq_ref_a + ctx->iq_sweep_a + MotorApp_FraInject(ctx, MOTORAPP_FRA_PT_IQ);
 
         float iq_comp_a = 0.0f;
 #if (MOTORAPP_IQ_LUT_COMP_ENABLE != 0U)
@@ -1145,15 +2784,17 @@ static void MotorApp_OnAdcPair(void *user, uint16_t adc1, uint16_t adc2)
         }
 #endif
         ctx->dbg_iq_comp_a = iq_comp_a;
-        iq_cmd_a += iq_comp_a;
-        if (iq_cmd_a > ctx->i_limit_a)
-        {
-            iq_cmd_a = ctx->i_limit_a;
-        }
-        if (iq_cmd_a < -ctx->i_limit_a)
-        {
-            iq_cmd_a = -ctx->i_limit_a;
-        }
+        iq_dem_a += iq_comp_a;
+
+        /* 电流矢量：MTPA 查表 + 弱磁 Id + 电流圆限幅；速度环按剩余的 Iq 限幅，反算积分也按这个限 */
+        float id_vec_a = 0.0f;
+        float iq_cmd_a = 0.0f;
+        const float iq_room_a =
+            CurrentVec_Apply(&ctx->ivec, iq_dem_a, ctx->fw.id_a, ctx->id_ref_a, &id_vec_a, &iq_cmd_a);
+        ctx->spd_ctrl.iq_limit_a = ((ctx->spd_loop_enabled != 0U) && (iq_room_a < MOTORAPP_SCTRL_IQ_LIMIT_A))
+                                       ? iq_room_a
+                                       : MOTORAPP_SCTRL_IQ_LIMIT_A;
+        const float id_cmd_a = id_vec_a + MotorApp_FraInject(ctx, MOTORAPP_FRA_PT_ID);
         ctx->dbg_iq_cmd_a = iq_cmd_a;
 
         const float theta_e = ctx->theta_e_ctrl_rad;
@@ -1162,18 +2803,60 @@ static void MotorApp_OnAdcPair(void *user, uint16_t adc1, uint16_t adc2)
         BspTrig_SinCos(theta_e, &s, &c);
 
         FocCurrentCtrlOut iout = {0};
+        float ud_ff_v = 0.0f;
         float uq_ff_v = 0.0f;
 #if (MOTORAPP_BEMF_FF_ENABLE != 0U)
-        uq_ff_v = MOTORAPP_BEMF_KE_V_PER_RAD_S * ctx->dbg_omega_pll_rad_s; // 反电动势前馈
+        uq_ff_v = ctx->motor_ke_v_s * ctx->dbg_omega_pll_rad_s; // 反电动势前馈
 #endif
-        FocCurrentCtrl_StepScFf(&ctx->i_ctrl, ctx->ia_a, ctx->ib_a, ctx->ic_a, s, c, ctx->id_ref_a, iq_cmd_a, 0.0f, uq_ff_v,
-                                &iout);
+        /* 交叉耦合前馈：电流给定没有采样噪声，实测电流在给定跟不上（饱和、过渡）时更准 */
+        if (ctx->dq_decouple_mode != 0U)
+        {
+            float id_dc_a = id_cmd_a;
+            float iq_dc_a = iq_cmd_a;
+            if (ctx->dq_decouple_mode == 2U)
+            {
+                FocCurrentCtrl_ParkSc(ctx->ia_a, ctx->ib_a, s, c, &id_dc_a, &iq_dc_a);
+            }
+            const float omega_e_rad_s = ctx->calib.p.pole_pairs * ctx->dbg_omega_pll_rad_s;
+            ctx->dbg_ud_dc_v = -omega_e_rad_s * ctx->motor_lq_h * iq_dc_a;
+            ctx->dbg_uq_dc_v = omega_e_rad_s * ctx->motor_ld_h * id_dc_a;
+        }
+        else
+        {
+            ctx->dbg_ud_dc_v = 0.0f;
+            ctx->dbg_uq_dc_v = 0.0f;
+        }
+        ud_ff_v += ctx->dbg_ud_dc_v + MotorApp_FraInject(ctx, MOTORAPP_FRA_PT_UD);
+        uq_ff_v += ctx->dbg_uq_dc_v;
+        FocCurrentCtrl_StepScFf(&ctx->i_ctrl, ctx->ia_a, ctx->ib_a, ctx->ic_a, s, c, id_cmd_a, iq_cmd_a, ud_ff_v,
+                                uq_ff_v, &iout);
+
+        switch (ctx->fra_point)
+        {
+        case MOTORAPP_FRA_PT_ID:
+            FreqResp_Accumulate(&ctx->fra, id_cmd_a, iout.id_a);
+            break;
+        case MOTORAPP_FRA_PT_IQ:
+            FreqResp_Accumulate(&ctx->fra, iout.iq_a, ctx->dbg_omega_pll_rad_s);
+            break;
+        case MOTORAPP_FRA_PT_SPD:
+            FreqResp_Accumulate(&ctx->fra, ctx->fra_omega_ref_rad_s, ctx->dbg_omega_pll_rad_s);
+            break;
+        case MOTORAPP_FRA_PT_UD:
+            FreqResp_Accumulate(&ctx->fra, iout.ud_v, iout.id_a);
+            break;
+        default:
+            break;
+        }
 
         ctx->dbg_theta_e = theta_e;
         ctx->dbg_ud = iout.ud_pu;
         ctx->dbg_uq = iout.uq_pu;
         ctx->dbg_id_a = iout.id_a;
         ctx->dbg_iq_a = iout.iq_a;
+        CurrentPredictDq_Commit(&ctx->i_predict, iout.id_a, iout.iq_a, iout.ud_v, iout.uq_v);
+        MotorApp_RlsAccumulate(ctx, iout.uq_v, iout.id_a, iout.iq_a,
+                               sqrtf((iout.ud_pu * iout.ud_pu) + (iout.uq_pu * iout.uq_pu)));
 
         /* 占空比生成的归一化 */
         /* pu-Per Unit 标幺值 */
@@ -1185,6 +2868,102 @@ static void MotorApp_OnAdcPair(void *user, uint16_t adc1, uint16_t adc2)
 
         MotorApp_OutputVdqSc(ctx, iout.ud_pu, iout.uq_pu, s, c);
     }
+    /* 死区辨识：只给 Id，用实测电角度定向（转子不受转矩），补偿在 OutputVdqSc 中暂时关闭 */
+    else if ((ctx->dtc_ident.state == DEADTIME_IDENT_RUN) && (ctx->i_offset_ready != 0U))
+    {
+        const float theta_e = ctx->theta_e_ctrl_rad;
+        float s = 0.0f;
+        float c = 1.0f;
+        BspTrig_SinCos(theta_e, &s, &c);
+
+        FocCurrentCtrlOut iout = {0};
+        const float id_ref = DeadTimeIdent_IdRef(&ctx->dtc_ident);
+        FocCurrentCtrl_StepScFf(&ctx->i_ctrl, ctx->ia_a, ctx->ib_a, ctx->ic_a, s, c, id_ref, 0.0f, 0.0f, 0.0f, &iout);
+        DeadTimeIdent_Tick(&ctx->dtc_ident, iout.id_a, iout.ud_v,
+                           DeadTimeIdent_SignProjD(ctx->ia_a, ctx->ib_a, ctx->ic_a, s, c));
+
+        ctx->dbg_theta_e = theta_e;
+        ctx->dbg_id_a = iout.id_a;
+        ctx->dbg_iq_a = iout.iq_a;
+        ctx->dbg_ud_pu = iout.ud_pu;
+        ctx->dbg_uq_pu = iout.uq_pu;
+        ctx->dbg_u_mag_pu = sqrtf((iout.ud_pu * iout.ud_pu) + (iout.uq_pu * iout.uq_pu));
+
+        if (ctx->dtc_ident.state == DEADTIME_IDENT_RUN)
+        {
+            MotorApp_OutputVdqSc(ctx, iout.ud_pu, iout.uq_pu, s, c);
+        }
+        else
+        {
+            /* 完成：Vdt(V) -> 占空比；失败则保持原幅值 */
+            if ((ctx->dtc_ident.state == DEADTIME_IDENT_DONE) && (ctx->i_ctrl.vbus_v > 0.0f))
+            {
+                float duty = ctx->dtc_ident.vdt_v / ctx->i_ctrl.vbus_v;
+                if (duty > MOTORAPP_DTC_DUTY_MAX)
+                {
+                    duty = MOTORAPP_DTC_DUTY_MAX;
+                }
+                ctx->dtc.duty_comp = duty;
+            }
+            FocCurrentCtrl_Reset(&ctx->i_ctrl);
+            (void)BspTim1Pwm_DisableOutputs(&ctx->pwm);
+        }
+    }
+    /* R/L 辨识：闭环段只给 Id；注入段电流环退出，按辨识器给出的 dq 电压开环输出 */
+    else if ((ctx->rl_ident.state == RL_IDENT_RUN) && (ctx->i_offset_ready != 0U))
+    {
+        const float theta_e = ctx->theta_e_ctrl_rad;
+        float s = 0.0f;
+        float c = 1.0f;
+        BspTrig_SinCos(theta_e, &s, &c);
+
+        float id_a = 0.0f;
+        float iq_a = 0.0f;
+        float ud_v = 0.0f;
+        float uq_v = 0.0f;
+        if (RlIdent_PiPhase(&ctx->rl_ident) != 0U)
+        {
+            FocCurrentCtrlOut iout = {0};
+            FocCurrentCtrl_StepScFf(&ctx->i_ctrl, ctx->ia_a, ctx->ib_a, ctx->ic_a, s, c, RlIdent_IdRef(&ctx->rl_ident),
+                                    0.0f, 0.0f, 0.0f, &iout);
+            RlIdent_TickPi(&ctx->rl_ident, iout.id_a, iout.ud_v, iout.uq_v);
+            id_a = iout.id_a;
+            iq_a = iout.iq_a;
+            ud_v = iout.ud_v;
+            uq_v = iout.uq_v;
+        }
+        else
+        {
+            FocCurrentCtrl_ParkSc(ctx->ia_a, ctx->ib_a, s, c, &id_a, &iq_a);
+            RlIdent_TickInject(&ctx->rl_ident, id_a, iq_a, &ud_v, &uq_v);
+        }
+
+        const float inv_vbus = (ctx->i_ctrl.vbus_v > 0.0f) ? (1.0f / ctx->i_ctrl.vbus_v) : 0.0f;
+        ctx->dbg_theta_e = theta_e;
+        ctx->dbg_id_a = id_a;
+        ctx->dbg_iq_a = iq_a;
+        ctx->dbg_ud_pu = ud_v * inv_vbus;
+        ctx->dbg_uq_pu = uq_v * inv_vbus;
+        ctx->dbg_u_mag_pu = sqrtf((ctx->dbg_ud_pu * ctx->dbg_ud_pu) + (ctx->dbg_uq_pu * ctx->dbg_uq_pu));
+
+        if (ctx->rl_ident.state == RL_IDENT_RUN)
+        {
+            MotorApp_OutputVdqSc(ctx, ctx->dbg_ud_pu, ctx->dbg_uq_pu, s, c);
+        }
+        else
+        {
+            /* 完成：写入 R/Ld/Lq，按带宽重算 PI（Kp = L*wc，Ki = R*wc）；失败则保持原参数 */
+            if (ctx->rl_ident.state == RL_IDENT_DONE)
+            {
+                const float wc = 6.28318530718f * ctx->rl_tune_bw_hz;
+                const float l_h = 0.5f * (ctx->rl_ident.ld_h + ctx->rl_ident.lq_h);
+                MotorApp_ApplyMotorRl(ctx, ctx->rl_ident.r_ohm, ctx->rl_ident.ld_h, ctx->rl_ident.lq_h);
+                FocCurrentCtrl_SetGains(&ctx->i_ctrl, l_h * wc, ctx->rl_ident.r_ohm * wc);
+            }
+            FocCurrentCtrl_Reset(&ctx->i_ctrl);
+            (void)BspTim1Pwm_DisableOutputs(&ctx->pwm);
+        }
+    }
     /* d轴开环强拖 */
     else if (ctx->vtest_active != 0U)
     {
@@ -1229,6 +3008,7 @@ static void MotorApp_OnAdcPair(void *user, uint16_t adc1, uint16_t adc2)
     }
 
 isr_exit:
+    MotorApp_IsrTimingExit(ctx);
     S_GPIO_Port->BSRR = (uint32_t)S_Pin << 16U;
 }
 
@@ -1251,28 +3031,112 @@ void MotorApp_Init(MotorApp *ctx, UART_HandleTypeDef *huart, SPI_HandleTypeDef *
     ctx->i_v_offset_raw = 0U;
     ctx->i_w_offset_raw = 0U;
     ctx->i_pair_active = CURRENT_SENSE_PAIR_AB;
+    ctx->i_adc_samples = 1U;
+    ctx->i_adc_ovs_enable = (MOTORAPP_ADC_OVS_MAX_SAMPLES > 1U) ? 1U : 0U;
+    ctx->i_pair_valid_active = 1U;
+    ctx->i_predict_enable = MOTORAPP_CURRENT_PREDICT_ENABLE;
+    MotorApp_ApplyMotorRl(ctx, MOTORAPP_MOTOR_RS_OHM, MOTORAPP_MOTOR_LD_H, MOTORAPP_MOTOR_LQ_H);
+    RlIdent_Abort(&ctx->rl_ident);
+    ctx->rl_tune_bw_hz = MOTORAPP_ICTRL_BW_HZ;
+    FreqResp_Reset(&ctx->fra);
+    ctx->fra_point = MOTORAPP_FRA_PT_NONE;
+    ctx->fra_request_point = MOTORAPP_FRA_PT_NONE;
+    ctx->fra_request_amp = 0.0f;
+    ctx->fra_request_pending = 0U;
+    ctx->fra_inj = 0.0f;
+    ctx->fra_omega_ref_rad_s = 0.0f;
+    ctx->fra_tx_idx = 0U;
+    SpeedIdent_Abort(&ctx->spd_ident);
+    ctx->spd_tune_bw_hz = MOTORAPP_SPD_TUNE_BW_HZ;
+    ctx->spd_ident_div_countdown = 0U;
+    ctx->spd_pll_kp = MOTORAPP_SPD_PLL_KP;
+    ctx->spd_pll_ki = MOTORAPP_SPD_PLL_KI;
 
     ctx->vbus_raw = 0U;
     ctx->vbus_v = MOTORAPP_VBUS_V;
     ctx->last_vbus_tick_ms = HAL_GetTick();
 
     ctx->i_trip_a = MOTORAPP_I_TRIP_A;
-    ctx->fault_overcurrent = 0U;
+    ctx->ocp_trip_a = MOTORAPP_OCP_TRIP_A;
+    ctx->ocp_enable = 1U;
+    ctx->ocp_pending = 1U;
+    FaultMgr_Init(&ctx->fault, g_motorapp_fault_react);
+    ctx->fault_tx_idx = 0U;
 
     ctx->enc_div_countdown = 0U;
     ctx->enc_dma_enable = 1U;
-
-    ctx->i_limit_a = MOTORAPP_I_LIMIT_A;
+    ctx->enc_frame_expected = 0U;
+    ctx->enc_status = 0U;
+    ctx->enc_bad_run = 0U;
+    ctx->enc_crc_err_count = 0U;
+    ctx->enc_status_rej_count = 0U;
+    ctx->enc_missing_count = 0U;
+
+    ctx->i_limit_a = MOTORAPP_I_RANGE_A;
+    const float therm_dt_s = (float)MOTORAPP_THERM_DIV / MOTORAPP_CTRL_HZ;
+    ThermalRc_Init(&ctx->therm_motor, therm_dt_s, MOTORAPP_THERM_MOTOR_GAIN_FAST, MOTORAPP_THERM_MOTOR_TAU_FAST_S,
+                   MOTORAPP_THERM_MOTOR_GAIN_SLOW, MOTORAPP_THERM_MOTOR_TAU_SLOW_S, MOTORAPP_THERM_T_AMB_C,
+                   MOTORAPP_THERM_MOTOR_T_DERATE_C, MOTORAPP_THERM_MOTOR_T_MAX_C);
+    ThermalRc_Init(&ctx->therm_inv, therm_dt_s, MOTORAPP_THERM_INV_GAIN, MOTORAPP_THERM_INV_TAU_S, 0.0f, 0.0f,
+                   MOTORAPP_THERM_T_AMB_C, MOTORAPP_THERM_INV_T_DERATE_C, MOTORAPP_THERM_INV_T_MAX_C);
+    ctx->therm_tick = 0U;
+    ctx->therm_acc_i2 = 0.0f;
+    ctx->therm_i2_a2 = 0.0f;
     ctx->id_ref_a = 0.0f;
     ctx->iq_ref_a = 0.0f;
     ctx->i_loop_enabled = 0U;
     ctx->i_loop_enable_pending = 0U;
+    ctx->pwm_ovm_enable = MOTORAPP_PWM_OVM_ENABLE;
+    ctx->pwm_zs_mode = (MOTORAPP_PWM_ZS_MODE < (uint32_t)SVPWM_ZS_COUNT) ? (uint8_t)MOTORAPP_PWM_ZS_MODE : 0U;
+    ctx->pwm_zs_active = 0U;
+    DeadTimeComp_Init(&ctx->dtc, MOTORAPP_DTC_DUTY, MOTORAPP_DTC_I_BAND_A);
+    DeadTimeIdent_Abort(&ctx->dtc_ident);
     FocCurrentCtrl_Init(&ctx->i_ctrl, MOTORAPP_ICTRL_KP, MOTORAPP_ICTRL_KI, 1.0f / MOTORAPP_CTRL_HZ, ctx->vbus_v,
-                        MOTORAPP_V_LIMIT_PU);
+                        (ctx->pwm_ovm_enable != 0U) ? SVPWM_OVM_SIX_STEP_PU : MOTORAPP_V_LIMIT_PU);
 
     ctx->target_vel_rad_s = 0.0f;
     ctx->spd_loop_enabled = 0U;
     ctx->spd_loop_div_countdown = 0U;
+    MultiTurnPos_Reset(&ctx->enc_mt);
+    ctx->pos_loop_enabled = 0U;
+    ctx->pos_loop_div_countdown = 0U;
+    ctx->pos_origin_count = 0;
+    ctx->pos_target_rad = 0.0f;
+    ctx->pos_plan_pending = 0U;
+    ctx->pos_traj_ready = 0U;
+    ctx->pos_traj_base_rad = 0.0f;
+    ctx->pos_traj_next_base_rad = 0.0f;
+    SCurvePos_Reset(&ctx->pos_traj);
+    SCurvePos_Reset(&ctx->pos_traj_next);
+    ctx->pos_ref_acc_rad_s2 = 0.0f;
+    ctx->spd_iq_ff_a = 0.0f;
+    ctx->spd_iq_pi_a = 0.0f;
+    ctx->spd_omega_err_rad_s = 0.0f;
+    SpeedFf_Init(&ctx->spd_ff, MOTORAPP_MOTOR_J_KGM2, MOTORAPP_MOTOR_B_NMS, MOTORAPP_MOTOR_TC_NM, MOTORAPP_MOTOR_KT_NM_A,
+                 MOTORAPP_SPD_FF_COUL_BAND_RAD_S);
+    ctx->spd_ff_enable = (MOTORAPP_SPD_FF_ENABLE != 0U) ? 1U : 0U;
+    ctx->rls_j_ref_kgm2 = MOTORAPP_MOTOR_J_KGM2;
+    DistObs_Init(&ctx->spd_dob, MOTORAPP_MOTOR_J_KGM2, MOTORAPP_MOTOR_B_NMS, MOTORAPP_MOTOR_KT_NM_A,
+                 MOTORAPP_DOB_BW_RAD_S, ((float)MOTORAPP_SPEED_LOOP_DIV) * (1.0f / MOTORAPP_CTRL_HZ));
+    ctx->motor_ke_v_s = MOTORAPP_BEMF_KE_V_PER_RAD_S;
+    ctx->rls_ke_ref_v_s = MOTORAPP_BEMF_KE_V_PER_RAD_S;
+    ctx->dq_decouple_mode = (MOTORAPP_DQ_DECOUPLE_MODE <= 2U) ? (uint8_t)MOTORAPP_DQ_DECOUPLE_MODE : 0U;
+    ctx->fw_enable = (MOTORAPP_FW_ENABLE != 0U) ? 1U : 0U;
+    FieldWeaken_Init(&ctx->fw, MOTORAPP_FW_KI, 1.0f / MOTORAPP_CTRL_HZ, MOTORAPP_FW_U_RATIO, MOTORAPP_FW_ID_MIN_A);
+    ctx->dbg_ud_dc_v = 0.0f;
+    ctx->dbg_uq_dc_v = 0.0f;
+    ctx->rls_apply = (MOTORAPP_RLS_MODE <= 2U) ? (uint8_t)MOTORAPP_RLS_MODE : 0U;
+    ctx->rls_win_tick = 0U;
+    ctx->rls_win_ready = 0U;
+    MotorApp_RlsReset(ctx);
+    ctx->spd_dob_enable = (MOTORAPP_DOB_ENABLE != 0U) ? 1U : 0U;
+    ctx->spd_iq_dob_a = 0.0f;
+    ctx->pos_ref_rad = 0.0f;
+    ctx->pos_ref_vel_rad_s = 0.0f;
+    ctx->pos_err_rad = 0.0f;
+    ctx->pos_omega_ref_rad_s = 0.0f;
+    FocPosCtrl_Init(&ctx->pos_ctrl, MOTORAPP_POSCTRL_KP, MOTORAPP_POSCTRL_KI, MOTORAPP_POS_LOOP_DT_S,
+                    MOTORAPP_SCTRL_OMEGA_LIMIT_RAD_S);
     FocSpeedCtrl_Init(&ctx->spd_ctrl, MOTORAPP_SPDCTRL_KP, MOTORAPP_SPDCTRL_KI,
                       ((float)MOTORAPP_SPEED_LOOP_DIV) * (1.0f / MOTORAPP_CTRL_HZ), MOTORAPP_SCTRL_IQ_LIMIT_A);
     SCurveVel_Init(&ctx->spd_ref_plan, ((float)MOTORAPP_SPEED_LOOP_DIV) * (1.0f / MOTORAPP_CTRL_HZ),
@@ -1290,16 +3154,49 @@ void MotorApp_Init(MotorApp *ctx, UART_HandleTypeDef *huart, SPI_HandleTypeDef *
     (void)HostCmdApp_Start(&ctx->host_cmd);
 
     BspTim1Pwm_Init(&ctx->pwm, htim_pwm);
+    /* 控制中断时序监控用 DWT 周期计数器；中心对齐 PWM 周期 = 2*ARR */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0U;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    IsrTiming_Init(&ctx->isr_timing, 2U * ctx->pwm.period, MOTORAPP_ISR_OVR_WIN_TICKS, MOTORAPP_ISR_OVR_MAX_PER_WIN);
+    /* 比较器/DAC/BRK2 要在 MOE 置位之前配好；门限等零偏出来后由主循环写入 */
+    BspOcpComp_Init(&ctx->ocp, (htim_pwm != 0) ? htim_pwm->Instance : 0, g_motorapp_ocp_ch, MOTORAPP_OCP_N_CH,
+                    MOTORAPP_OCP_BRK2_FILTER);
+    ctx->enc_tim_trigger = 0U;
+#if (MOTORAPP_ENC_TIM_TRIGGER != 0U)
+    /* ADC 触发挪到 OC6，CH4 比较事件留给编码器 DMA，必须在计数器启动前配置 */
+    const uint8_t enc_trig_tim_ok =
+        (BspTim1Pwm_ConfigEncoderTrigger(&ctx->pwm, MOTORAPP_ADC_TRIG_CCR,
+                                         MOTORAPP_ADC_TRIG_CCR - MOTORAPP_ENC_TRIG_LEAD_TICKS) == HAL_OK)
+            ? 1U
+            : 0U;
+#endif
     (void)BspTim1Pwm_StartTrigger(&ctx->pwm);
 
     BspAdcInjPair_Init(&ctx->adc_inj, hadc1, hadc2);
     BspAdcInjPair_RegisterCallback(&ctx->adc_inj, ctx, MotorApp_OnAdcPair);
-    MotorApp_ProgramCurrentPair(ctx, CURRENT_SENSE_PAIR_AB);
+    (void)BspAdcInjPair_ConfigOversampling(&ctx->adc_inj, (uint8_t)MOTORAPP_ADC_OVS_HW_RATIO,
+                                           (uint8_t)MOTORAPP_ADC_OVS_MAX_SAMPLES);
+    /* offset 校准阶段输出关闭，窗口足够，直接用最多次数采样 */
+    MotorApp_ProgramCurrentPair(ctx, CURRENT_SENSE_PAIR_AB, (uint8_t)MOTORAPP_ADC_OVS_MAX_SAMPLES);
     (void)BspAdcInjPair_Start(&ctx->adc_inj);
 
     BspSpi3Fast_Init(&ctx->spi, hspi, cs_port, cs_pin);
 
     BspMt6835Dma_Init(&ctx->enc_dma, hspi, cs_port, cs_pin);
+#if (MOTORAPP_ENC_TIM_TRIGGER != 0U)
+    /* DMA1_Channel5 / DMAMUX1_Channel4 空闲，接 TIM1_CH4 请求 */
+    if (enc_trig_tim_ok != 0U)
+    {
+        ctx->enc_tim_trigger = BspMt6835Dma_ConfigTimerTrigger(&ctx->enc_dma, htim_pwm->Instance, TIM_DIER_CC4DE,
+                                                               DMA1_Channel5, DMAMUX1_Channel4, DMA_REQUEST_TIM1_CH4);
+    }
+#endif
+    ctx->spd_obs_mode = (MOTORAPP_SPD_OBS_MODE != 0U) ? 1U : 0U;
+    AngleObserver3_Init(&ctx->spd_ato, MOTORAPP_SPD_ATO_BW_RAD_S,
+                        ((float)MOTORAPP_ENCODER_READ_DIV) * (1.0f / MOTORAPP_CTRL_HZ),
+                        (MOTORAPP_SPD_ATO_IQ_FF != 0U) ? (MOTORAPP_MOTOR_KT_NM_A / MOTORAPP_MOTOR_J_KGM2) : 0.0f);
+    ctx->theta_ctrl_tcomp_s = (ctx->enc_tim_trigger != 0U) ? MOTORAPP_THETA_CTRL_TCOMP_TRIG_S : MOTORAPP_THETA_CTRL_TCOMP_S;
 
     Mt6835BusOps bus = {
         .user = &ctx->spi,
@@ -1320,6 +3217,10 @@ void MotorApp_Init(MotorApp *ctx, UART_HandleTypeDef *huart, SPI_HandleTypeDef *
         .min_move_rad = 0.2f,                               // 拖动阶段最小机械移动角度
     };
     MotorCalib_Init(&ctx->calib, &calib);
+    /* psi = Ke / 极对数，极对数在上面的校准参数里，必须放在 MotorCalib_Init 之后 */
+    CurrentVec_Init(&ctx->ivec, MOTORAPP_I_RANGE_A, ctx->motor_ke_v_s / ctx->calib.p.pole_pairs, ctx->motor_ld_h,
+                    ctx->motor_lq_h);
+    ctx->ivec_rebuild_pending = 0U;
     ctx->elec_dir = -1;
     ctx->elec_zero_offset_rad = 0.620399f;
 
@@ -1346,6 +3247,15 @@ void MotorApp_Loop(MotorApp *ctx)
     {
         MotorApp_HandleHostCmd(ctx, &cmd);
     }
+    MotorApp_PosPlanService(ctx);
+    MotorApp_RlsService(ctx);
+    MotorApp_OcpService(ctx);
+    if (ctx->ivec_rebuild_pending != 0U)
+    {
+        ctx->ivec_rebuild_pending = 0U;
+        CurrentVec_Build(&ctx->ivec, MOTORAPP_I_RANGE_A, ctx->motor_ke_v_s / ctx->calib.p.pole_pairs, ctx->motor_ld_h,
+                         ctx->motor_lq_h);
+    }
 
     if (ctx->calib_request_pending != 0U)
     {
@@ -1362,12 +3272,16 @@ void MotorApp_Loop(MotorApp *ctx)
 
     if (ctx->i_loop_enable_pending != 0U)
     {
-        if (ctx->i_offset_ready != 0U)
+        if (MotorApp_FaultLatched(ctx) != 0U)
         {
+            /* 命令发出后才出现的故障（如 Vbus 越限）：放弃这次使能 */
             ctx->i_loop_enable_pending = 0U;
-            ctx->i_loop_enabled = 1U;
-            FocCurrentCtrl_Reset(&ctx->i_ctrl);
-            (void)BspTim1Pwm_EnableOutputs(&ctx->pwm);
+        }
+        else if (ctx->i_offset_ready != 0U)
+        {
+            ctx->i_loop_enable_pending = 0U;
+            /* 上面的检查之后中断里仍可能报故障，TryEnable 内部关中断再查一次 */
+            (void)MotorApp_TryEnableOutputs(ctx, 1U);
         }
     }
 
@@ -1388,6 +3302,24 @@ void MotorApp_Loop(MotorApp *ctx)
                 const float vbus_new = vadc * MOTORAPP_VBUS_DIV;
                 ctx->vbus_v = ctx->vbus_v + (MOTORAPP_VBUS_FILTER_ALPHA * (vbus_new - ctx->vbus_v));
                 ctx->i_ctrl.vbus_v = ctx->vbus_v;
+
+                /* 欠压/过压：越限停机，回到范围内（带回差）解除，不需要 `I` 清除 */
+                if (ctx->vbus_v < MOTORAPP_VBUS_UV_V)
+                {
+                    MotorApp_RaiseFault(ctx, FAULT_VBUS_UNDER, ctx->vbus_v);
+                }
+                else if (ctx->vbus_v > (MOTORAPP_VBUS_UV_V + MOTORAPP_VBUS_HYST_V))
+                {
+                    MotorApp_ReleaseFault(ctx, FAULT_VBUS_UNDER);
+                }
+                if (ctx->vbus_v > MOTORAPP_VBUS_OV_V)
+                {
+                    MotorApp_RaiseFault(ctx, FAULT_VBUS_OVER, ctx->vbus_v);
+                }
+                else if (ctx->vbus_v < (MOTORAPP_VBUS_OV_V - MOTORAPP_VBUS_HYST_V))
+                {
+                    MotorApp_ReleaseFault(ctx, FAULT_VBUS_OVER);
+                }
             }
             /* 注意：不要调用 HAL_ADC_Stop()，它会关闭 ADC 并强行停止 injected 转换，导致 20kHz 控制中断消失 */
         }
@@ -1532,6 +3464,221 @@ void MotorApp_Loop(MotorApp *ctx)
         return;
     }
 
+    if (ctx->stream_page == 13U)
+    {
+        /* 本周期每通道转换次数、选中组合的较短下桥臂窗口、d/q 轴电流 */
+        JustFloat_Pack4((float)ctx->dbg_i_adc_samples, (float)ctx->dbg_i_pair_window_ticks, ctx->dbg_id_a, ctx->dbg_iq_a,
+                        ctx->tx_frame);
+        (void)BspUartDma_Send(&ctx->uart, ctx->tx_frame, (uint16_t)sizeof(ctx->tx_frame));
+        return;
+    }
+
+    if (ctx->stream_page == 34U)
+    {
+        /* 控制中断超时的 lateness 直方图（超出截止时间的量按 PWM 周期 P 分档） */
+        JustFloat_Pack4((float)ctx->isr_timing.late_hist[0], (float)ctx->isr_timing.late_hist[1],
+                        (float)ctx->isr_timing.late_hist[2], (float)ctx->isr_timing.late_hist[3], ctx->tx_frame);
+        (void)BspUartDma_Send(&ctx->uart, ctx->tx_frame, (uint16_t)sizeof(ctx->tx_frame));
+        return;
+    }
+
+    if (ctx->stream_page == 33U)
+    {
+        /* 控制中断时序：超时次数、丢拍数、最近 1s / 上电以来"触发 -> 中断退出"的最长时间（us，截止 = 1 个 PWM 周期） */
+        const float us_per_cyc = 1.0e6f / (float)SystemCoreClock;
+        JustFloat_Pack4((float)ctx->isr_timing.overrun_count, (float)ctx->isr_timing.miss_count,
+                        (float)ctx->isr_timing.t_end_win_max_cyc * us_per_cyc,
+                        (float)ctx->isr_timing.t_end_max_cyc * us_per_cyc, ctx->tx_frame);
+        (void)BspUartDma_Send(&ctx->uart, ctx->tx_frame, (uint16_t)sizeof(ctx->tx_frame));
+        return;
+    }
+
+    if (ctx->stream_page == 32U)
+    {
+        /* 故障历史：从最新一条往旧轮流发（锁存位、故障码、时间 s、触发值），没有记录时故障码为 0 */
+        const FaultRecord *rec = FaultMgr_History(&ctx->fault, ctx->fault_tx_idx);
+        ctx->fault_tx_idx = (uint8_t)(ctx->fault_tx_idx + 1U);
+        if (ctx->fault_tx_idx >= ctx->fault.hist_n)
+        {
+            ctx->fault_tx_idx = 0U;
+        }
+        JustFloat_Pack4((float)ctx->fault.latched_mask, (rec != 0) ? (float)rec->code : 0.0f,
+                        (rec != 0) ? ((float)rec->t_ms * 0.001f) : 0.0f, (rec != 0) ? rec->value : 0.0f,
+                        ctx->tx_frame);
+        (void)BspUartDma_Send(&ctx->uart, ctx->tx_frame, (uint16_t)sizeof(ctx->tx_frame));
+        return;
+    }
+
+    if (ctx->stream_page == 31U)
+    {
+        /* 热模型：绕组温度估计、逆变器温度估计、降额后的电流限幅、最近 10ms 的电流有效幅值 */
+        JustFloat_Pack4(ctx->therm_motor.temp_c, ctx->therm_inv.temp_c, ctx->i_limit_a, sqrtf(ctx->therm_i2_a2),
+                        ctx->tx_frame);
+        (void)BspUartDma_Send(&ctx->uart, ctx->tx_frame, (uint16_t)sizeof(ctx->tx_frame));
+        return;
+    }
+
+    if (ctx->stream_page == 30U)
+    {
+        /* 硬件过流：门限（A）、DAC 码值、是否接入 BRK2、故障锁存位（FAULT_MGR_BIT） */
+        JustFloat_Pack4(ctx->ocp_trip_a, (float)ctx->ocp.dac_code[0], (float)ctx->ocp.armed,
+                        (float)ctx->fault.latched_mask, ctx->tx_frame);
+        (void)BspUartDma_Send(&ctx->uart, ctx->tx_frame, (uint16_t)sizeof(ctx->tx_frame));
+        return;
+    }
+
+    if (ctx->stream_page == 29U)
+    {
+        /* 电流矢量：MTPA Id、Id 指令（含弱磁）、Iq 指令、|i| */
+        const float i_mag = sqrtf((ctx->ivec.id_a * ctx->ivec.id_a) + (ctx->ivec.iq_a * ctx->ivec.iq_a));
+        JustFloat_Pack4(ctx->ivec.id_mtpa_a, ctx->ivec.id_a, ctx->ivec.iq_a, i_mag, ctx->tx_frame);
+        (void)BspUartDma_Send(&ctx->uart, ctx->tx_frame, (uint16_t)sizeof(ctx->tx_frame));
+        return;
+    }
+
+    if (ctx->stream_page == 28U)
+    {
+        /* 弱磁：电压幅值（pu）、弱磁 Id、速度环 Iq 上限、速度反馈 */
+        JustFloat_Pack4(ctx->dbg_u_mag_pu, ctx->fw.id_a, ctx->spd_ctrl.iq_limit_a, ctx->dbg_omega_pll_rad_s,
+                        ctx->tx_frame);
+        (void)BspUartDma_Send(&ctx->uart, ctx->tx_frame, (uint16_t)sizeof(ctx->tx_frame));
+        return;
+    }
+
+    if (ctx->stream_page == 27U)
+    {
+        /* dq 交叉耦合前馈（V）与 dq 电流，用于高速下对比 X0/X1/X2 */
+        JustFloat_Pack4(ctx->dbg_ud_dc_v, ctx->dbg_uq_dc_v, ctx->dbg_id_a, ctx->dbg_iq_a, ctx->tx_frame);
+        (void)BspUartDma_Send(&ctx->uart, ctx->tx_frame, (uint16_t)sizeof(ctx->tx_frame));
+        return;
+    }
+
+    if (ctx->stream_page == 26U)
+    {
+        /* 在线参数跟踪：R（ohm）、Ke（mV/(rad/s)）、J（1e-6 kg*m^2）、负载转矩估计（mN*m） */
+        JustFloat_Pack4(ctx->rls_r_ohm, ctx->rls_ke_v_s * 1.0e3f, ctx->rls_j_kgm2 * 1.0e6f,
+                        ctx->rls_mech.theta[1] * MOTORAPP_MOTOR_KT_NM_A * 1.0e3f, ctx->tx_frame);
+        (void)BspUartDma_Send(&ctx->uart, ctx->tx_frame, (uint16_t)sizeof(ctx->tx_frame));
+        return;
+    }
+
+    if (ctx->stream_page == 25U)
+    {
+        /* 速度环自整定：状态、当前使用的 J（1e-6 kg*m^2）、B（1e-6 N*m*s/rad）、Tc（mN*m） */
+        JustFloat_Pack4((float)ctx->spd_ident.state, ctx->spd_ff.j_kgm2 * 1.0e6f, ctx->spd_ff.b_nms * 1.0e6f,
+                        ctx->spd_ff.tc_nm * 1.0e3f, ctx->tx_frame);
+        (void)BspUartDma_Send(&ctx->uart, ctx->tx_frame, (uint16_t)sizeof(ctx->tx_frame));
+        return;
+    }
+
+    if (ctx->stream_page == 24U)
+    {
+        /* 频响结果：每个完成的频点发一帧（序号、f、增益 dB、相位 deg），没有新点时不发 */
+        if (ctx->fra_tx_idx >= ctx->fra.n_done)
+        {
+            return;
+        }
+        const FreqRespPoint *pt = &ctx->fra.result[ctx->fra_tx_idx];
+        const float gain_db = (pt->gain > 0.0f) ? (20.0f * log10f(pt->gain)) : -200.0f;
+        JustFloat_Pack4((float)ctx->fra_tx_idx, pt->f_hz, gain_db, pt->phase_deg, ctx->tx_frame);
+        (void)BspUartDma_Send(&ctx->uart, ctx->tx_frame, (uint16_t)sizeof(ctx->tx_frame));
+        ctx->fra_tx_idx++;
+        return;
+    }
+
+    if (ctx->stream_page == 23U)
+    {
+        /* R/L 辨识状态（整数部分）和阶段（小数部分）、当前使用的 R（ohm）、Ld/Lq（uH） */
+        JustFloat_Pack4((float)ctx->rl_ident.state + (0.1f * (float)ctx->rl_ident.phase), ctx->motor_rs_ohm,
+                        ctx->motor_ld_h * 1.0e6f, ctx->motor_lq_h * 1.0e6f, ctx->tx_frame);
+        (void)BspUartDma_Send(&ctx->uart, ctx->tx_frame, (uint16_t)sizeof(ctx->tx_frame));
+        return;
+    }
+
+    if (ctx->stream_page == 22U)
+    {
+        /* 负载转矩估计（N*m）、扰动补偿 Iq、速度环 PI 部分、速度反馈 */
+        JustFloat_Pack4(ctx->spd_dob.td_hat_nm, ctx->spd_iq_dob_a, ctx->spd_iq_pi_a, ctx->dbg_omega_pll_rad_s,
+                        ctx->tx_frame);
+        (void)BspUartDma_Send(&ctx->uart, ctx->tx_frame, (uint16_t)sizeof(ctx->tx_frame));
+        return;
+    }
+
+    if (ctx->stream_page == 21U)
+    {
+        /* 速度环输出拆分：PI 部分、前馈合计、其中加速度项、速度误差（给定 - 反馈） */
+        JustFloat_Pack4(ctx->spd_iq_pi_a, ctx->spd_iq_ff_a, ctx->spd_ff.iq_acc_a, ctx->spd_omega_err_rad_s,
+                        ctx->tx_frame);
+        (void)BspUartDma_Send(&ctx->uart, ctx->tx_frame, (uint16_t)sizeof(ctx->tx_frame));
+        return;
+    }
+
+    if (ctx->stream_page == 20U)
+    {
+        /* 位置轨迹给定、实测位置（相对本次移动起点，rad）、轨迹速度、位置环输出速度给定 */
+        const float pos_meas_rad = (float)ctx->elec_dir *
+                                   (float)(MotorApp_EncMtCountSnapshot(ctx) - ctx->pos_origin_count) *
+                                   MULTITURN_POS_RAD_PER_COUNT;
+        JustFloat_Pack4(ctx->pos_ref_rad, pos_meas_rad, ctx->pos_ref_vel_rad_s, ctx->pos_omega_ref_rad_s,
+                        ctx->tx_frame);
+        (void)BspUartDma_Send(&ctx->uart, ctx->tx_frame, (uint16_t)sizeof(ctx->tx_frame));
+        return;
+    }
+
+    if (ctx->stream_page == 19U)
+    {
+        /* PLL 速度、观测器速度、观测器加速度（均为原始编码器方向）、观测器角度误差 */
+        JustFloat_Pack4(ctx->spd_omega_pll_rad_s, ctx->spd_ato.omega_rad_s, ctx->spd_ato.alpha_rad_s2, ctx->spd_ato.err_rad,
+                        ctx->tx_frame);
+        (void)BspUartDma_Send(&ctx->uart, ctx->tx_frame, (uint16_t)sizeof(ctx->tx_frame));
+        return;
+    }
+
+    if (ctx->stream_page == 18U)
+    {
+        /* 编码器 CRC 错误帧数、STATUS 报警丢弃帧数、丢帧数、最近一帧 STATUS */
+        JustFloat_Pack4((float)ctx->enc_crc_err_count, (float)ctx->enc_status_rej_count, (float)ctx->enc_missing_count,
+                        (float)ctx->enc_status, ctx->tx_frame);
+        (void)BspUartDma_Send(&ctx->uart, ctx->tx_frame, (uint16_t)sizeof(ctx->tx_frame));
+        return;
+    }
+
+    if (ctx->stream_page == 17U)
+    {
+        /* 死区补偿幅值、辨识状态、辨识得到的 R 与 Vdt */
+        JustFloat_Pack4(ctx->dtc.duty_comp, (float)ctx->dtc_ident.state, ctx->dtc_ident.r_ohm, ctx->dtc_ident.vdt_v,
+                        ctx->tx_frame);
+        (void)BspUartDma_Send(&ctx->uart, ctx->tx_frame, (uint16_t)sizeof(ctx->tx_frame));
+        return;
+    }
+
+    if (ctx->stream_page == 16U)
+    {
+        /* 零序注入方式、DPWM 是否生效、钳 0 相掩码、下周期采样组合 */
+        JustFloat_Pack4((float)ctx->pwm_zs_mode, (float)ctx->pwm_zs_active, (float)ctx->dbg_svm_clamp_low,
+                        (float)ctx->dbg_i_pair_next, ctx->tx_frame);
+        (void)BspUartDma_Send(&ctx->uart, ctx->tx_frame, (uint16_t)sizeof(ctx->tx_frame));
+        return;
+    }
+
+    if (ctx->stream_page == 15U)
+    {
+        /* 电压矢量幅值、过调制区域、PLL 速度、下周期采样组合有效性 */
+        JustFloat_Pack4(ctx->dbg_u_mag_pu, (float)ctx->dbg_svm_ovm_region, ctx->dbg_omega_pll_rad_s,
+                        (float)ctx->dbg_i_pair_valid, ctx->tx_frame);
+        (void)BspUartDma_Send(&ctx->uart, ctx->tx_frame, (uint16_t)sizeof(ctx->tx_frame));
+        return;
+    }
+
+    if (ctx->stream_page == 14U)
+    {
+        /* 采样有效 / 预测替代 / 无效仍用原始采样 三路计数，当前连续预测次数 */
+        JustFloat_Pack4((float)ctx->i_sample_meas_count, (float)ctx->i_sample_pred_count, (float)ctx->i_sample_raw_count,
+                        (float)ctx->i_predict.run_ticks, ctx->tx_frame);
+        (void)BspUartDma_Send(&ctx->uart, ctx->tx_frame, (uint16_t)sizeof(ctx->tx_frame));
+        return;
+    }
+
     const uint8_t calib_running =
         (ctx->dbg_calib_state == (uint8_t)MOTOR_CALIB_ALIGN) || (ctx->dbg_calib_state == (uint8_t)MOTOR_CALIB_SPIN);
     if (calib_running != 0U)
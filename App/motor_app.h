@@ -7,7 +7,10 @@
  *
  * HostCmd 命令表（建议以 `\r` / `\n` / `;` 结束；也支持 idle flush）：
  *
- * - `P<deg>`：占位（保存目标位置，当前不参与控制）。例如 `P90`。
+ * - `P<deg>`：位置模式，移动到多圈绝对位置（deg，上电首帧的单圈角度为起点，方向同速度）。例如 `P720`。
+ *   轨迹为七段 S 曲线（限速/限加速度/限加加速度下时间最优），位置环输出（带轨迹速度前馈）作速度环给定，
+ *   轨迹加速度/速度经速度环前馈到 Iq；移动中收到的新目标在本段走完后执行。切到 D20 页。
+ * - `P`：位置模式，保持当前位置。`V<rad_s>` 切回速度模式，`V0` / `I` 停止。
  * - `V<rad_s>`：速度环（外环）目标机械角速度（rad/s）。例如 `V50`。
  * - `V0` / `V`：停止速度环并关闭 PWM 输出。
  * - `C1` / `C`：启动一次校准（ALIGN -> SPIN -> DONE/FAIL），校准完成会自动关闭 PWM 输出。
@@ -20,31 +23,115 @@
  * - `M1`：写 MT6835 寄存器 `0x011` 的 BW[2:0]（高 5 位保持不变，BW 默认写 7），再读回校验并切到 D4 页打印。
  * - `F1`：启动 Iq 注入对数扫频（系统辨识用），并切到 D6 页打印。
  * - `F0`：停止扫频注入。
+ * - `H<pt>`：片上频率响应分析（步进正弦，频点间自动切换，测量窗口取整数周期，sin/cos 相关求增益/相位）：
+ *   `H1` id_ref->id，`H2` iq->omega，`H3` omega_ref->omega（需速度环运行），`H4` ud->id；`H0` / `H` 停止。
+ *   需电流环运行；频点范围/幅值见 signal_config.h，上限 CTRL_HZ/4。切到 D24 页，每完成一个频点发一帧。
+ * - `O1` / `O`：按选中采样组合的下桥臂窗口自适应每周期多次转换（1/2/4，受编译期上限约束）；`O0`：固定单次。
+ * - `S1` / `S`：采样窗口不足时用 dq 预测电流代替；`S0`：直接用原始采样。两者都会清零计数并切到 D14 页。
+ * - `W1`：允许过调制（区域 I/II 平滑过渡到六拍，电压限幅放宽到 2/pi）；`W0` / `W`：线性区 SVPWM。切到 D15 页。
+ * - `Z<n>`：零序注入方式，`Z0` / `Z` 连续 SVPWM，`Z1` DPWM0，`Z2` DPWM1，`Z3` DPWMMAX，`Z4` DPWMMIN；
+ *   |u| >= 0.35 切入、< 0.30 切回连续，切到 D16 页。
+ * - `K<duty>`：死区补偿幅值（占空比，`K0` 关闭）；`K`：静止 Id 台阶扫描自动辨识补偿幅值（需 offset 就绪），切到 D17 页。
+ *   辨识期间收到 D/K 以外的命令会中止辨识并关闭输出。
+ * - `R<bw_hz>`（>=50）/ `R`：静止辨识 R（Id 两点）和 Ld/Lq（PRBS 电压注入 + 最小二乘，约 0.7s），
+ *   成功后按带宽（默认 1kHz）重算电流环 Kp = L*wc、Ki = R*wc 并更新 dq 电流预测；`R0` 恢复编译期参数。
+ *   需 offset 就绪且已校准；辨识期间收到 D/R 以外的命令会中止并关闭输出。切到 D23 页。
+ * - `A1` / `A`：速度反馈改用三阶角度跟踪观测器（角度/速度/加速度，带 Kt/J*iq 前馈）；`A0`：二阶 PLL；
+ *   `A<bw>`（>=10）同时设置观测器带宽（rad/s）。切到 D19 页。
+ * - 编码器每帧做 CRC8 校验并检查 STATUS；坏帧/丢帧时按 PLL 速度外推角度，连续超过上限则锁存编码器故障并停机，`I` 清除。
+ * - `J<uJ>` / `B<uB>` / `U<mNm>`：速度环 Iq 前馈 (J*a + B*omega + Tc*sign(omega)) / Kt 的系数，
+ *   J 单位 1e-6 kg*m^2，B 单位 1e-6 N*m*s/rad，U 为库仑摩擦 mN*m；`J0` 关闭前馈，不带数值恢复默认。
+ *   a/omega 取速度指令 S 曲线（速度模式）或位置轨迹（位置模式）。切到 D21 页。
+ * - `G1` / `G`：速度环加负载转矩扰动补偿（Td_hat / Kt）；`G0`：只估计不补偿；`G<bw>`（>=10）同时设观测器带宽 rad/s（默认 400）。
+ *   观测器在速度环运行时一直更新，切到 D22 页。
+ * - `L<bw_hz>`（>=1）/ `L`：速度环自整定，电流环给 ±0.5A 在 ±150rad/s 之间加减速两轮（中间滑行），
+ *   RLS 辨识 J / B / 库仑摩擦，成功后写入前馈/观测器，并按穿越频率（默认 40Hz）重算 Kp = J*wc/Kt、Ki = Kp*wc/4，
+ *   PLL 与角度观测器带宽取 2*wc；结束后关闭输出。`L0` 恢复编译期参数。需已校准；期间收到 D/L 以外的命令会中止。切到 D25 页。
+ * - `E0`：在线 RLS 只估计 R/Ke（q 轴稳态电压方程）和 J（速度环加减速段），`E1`：R/Ke 写入反电动势前馈、
+ *   dq 电流预测和电流环 Ki（保持带宽），`E2`：再把 J 写入速度环前馈/扰动观测器；`E`：估计器复位到当前参数。
+ *   电流环运行时一直在后台更新（10ms 窗口，遗忘因子 0.998，激励不足的窗口跳过），写入值限制在参考值的 0.5~2 倍
+ *   （参考值取最近一次 R/L 辨识结果或 R0/L0 恢复的参数，RLS 自己的写入不改参考值）。切到 D26 页。
+ * - `X1` / `X`：dq 交叉耦合前馈 ud += -we*Lq*iq、uq += we*Ld*id（与反电动势前馈叠加），用电流给定；
+ *   `X2`：用本拍实测电流；`X0`：关闭（上电默认）。Ld/Lq 取运行时参数（R 命令辨识后更新）。切到 D27 页。
+ * - `N1` / `N`：速度环弱磁，|u| 超过 0.95 倍电压限幅时积分出负 Id（最多 -2A），Iq 限在电流圆剩余部分，
+ *   速度指令上限提到 2000rad/s；`N0`：关闭，Id 平滑积分回 0。切到 D28 页。
+ * - 电流给定统一经过电流矢量管理：速度环/I 命令给出的 Iq 视为转矩需求，按 MTPA 表（Ld/Lq 运行时参数，表贴电机 Id=0）
+ *   换成 (Id, Iq)，叠加弱磁 Id 后限在 I_LIMIT 电流圆内。`Y0` / `Y`：D 优先（默认），`Y1`：Q 优先。切到 D29 页。
+ * - `Q<A>`：硬件过流门限（相电流峰值 A），片上比较器 + DAC 门限直接接 TIM1 BRK2，不经软件 < 1us 关断；
+ *   `Q0`：断开比较器（软件过流检测仍在），`Q`：恢复默认门限。零偏就绪后才接入；跳闸后 `I` 在比较器回落后才清故障。切到 D30 页。
+ * - 故障统一由故障管理处理（fault_mgr.h 故障码，D30/D32 的掩码按 1<<code）：过流（软件/比较器/BKIN）、编码器（CRC/STATUS、无帧）
+ *   停机并锁存，`I` 清除；Vbus 欠压/过压停机，回到范围内自动解除；采样连续无效只记录。出故障时统一停机（关中断、先关输出、
+ *   清所有环路/注入/辨识），故障存在期间所有使能输出的命令（P/V/I/C/T/K/R/L）都被忽略。最近 16 条带时间戳记录在 D32 页。
+ * - 控制中断时序监控：入口/出口记 DWT 周期数，出口按 TIM1 计数相位算"ADC 触发 -> 中断退出"的时间，超过一个 PWM 周期
+ *   （或中断期间 ADC 又完成一次注入序列）记超时，相邻入口间隔 > 1.5 周期记丢拍；1s 内超时 + 丢拍超过上限报 FAULT_ISR_OVERRUN
+ *   （默认只记录，`MOTORAPP_ISR_OVR_REACT` 可改为停机/锁存）。D33/D34 页。
+ * - `MOTORAPP_THERM_ENABLE=1` 时电流限幅 `i_limit`（I 命令、电流圆、速度环）由 I^2t 热模型动态降额：冷态到 `MOTORAPP_I_PEAK_A`，
+ *   绕组/逆变器温度估计超过降额起点后线性降到持续电流。默认关闭（固定 I_LIMIT，参数未标定），模型照常估温度，D31 页看。
  * - `D` / `D<n>`：切换/设置数据流页面（JustFloat_Pack4）。
  *   - `D5`：omega_ref / omega_pll / Iq_ref / Iq_meas
  *   - `D7`：raw21 / omega_pll / Iq_ref / Iq_meas（用于按角度做全周期 LUT 分析）
  *   - `D8`：omega_pll / Iq_ref / Iq_comp / Iq_cmd（补偿观测）
  *   - `D11`：theta_e_meas / theta_e_ctrl / delta_theta_deg / u_mag_pu
  *   - `D12`：ud_pu / uq_pu / u_mag_pu / delta_theta_deg
+ *   - `D13`：adc_samples / pair_window_ticks / Id_meas / Iq_meas
+ *   - `D14`：sample_meas_count / sample_pred_count / sample_raw_count / predict_run_ticks
+ *   - `D15`：u_mag_pu / ovm_region / omega_pll / pair_valid
+ *   - `D16`：zs_mode / dpwm_active / clamp_low_mask / pair_next
+ *   - `D17`：dtc_duty / dtc_ident_state / ident_R / ident_Vdt
+ *   - `D18`：enc_crc_err_count / enc_status_rej_count / enc_missing_count / enc_status
+ *   - `D19`：omega_pll / omega_ato / alpha_ato / ato_err（编码器原始方向）
+ *   - `D20`：pos_ref / pos_meas / pos_ref_vel / pos_omega_ref（rad，相对本次移动起点）
+ *   - `D21`：iq_pi / iq_ff / iq_ff_acc / omega_err（速度环 PI 与前馈拆分）
+ *   - `D22`：td_hat_Nm / iq_dob / iq_pi / omega_pll（负载转矩估计）
+ *   - `D23`：rl_state(+0.1*phase) / R_ohm / Ld_uH / Lq_uH
+ *   - `D24`：idx / f_Hz / gain_dB / phase_deg（频响结果，只在有新点时发送；`D24` 从头重发）
+ *   - `D25`：spd_ident_state / J_uKgm2 / B_uNms / Tc_mNm（当前使用的机械参数）
+ *   - `D26`：R_ohm / Ke_mV_s / J_uKgm2 / Tl_mNm（在线 RLS 估计值）
+ *   - `D27`：ud_dc_V / uq_dc_V / Id / Iq（dq 交叉耦合前馈）
+ *   - `D28`：u_mag_pu / id_fw / spd_iq_limit / omega_pll（弱磁）
+ *   - `D29`：id_mtpa / id_cmd / iq_cmd / i_mag（电流矢量）
+ *   - `D30`：ocp_trip_A / dac_code / armed / fault_latched_mask（硬件过流）
+ *   - `D31`：T_motor / T_inverter / i_limit / i_rms（热模型）
+ *   - `D32`：fault_latched_mask / code / t_s / value（故障历史，从新到旧轮流发送，`D32` 从最新一条重发）
+ *   - `D33`：overrun_count / miss_count / t_end_max_us(1s 窗口) / t_end_max_us(上电以来)（控制中断时序）
+ *   - `D34`：lateness 直方图 (0,P/4] / (P/4,P/2] / (P/2,P] / >P，P = PWM 周期
  */
 
+#include "angle_observer.h"
 #include "bsp_adc_inj_pair.h"
 #include "bsp_mt6835_dma.h"
+#include "bsp_ocp_comp.h"
 #include "bsp_spi3_fast.h"
 #include "bsp_tim1_pwm.h"
 #include "bsp_trig.h"
 #include "bsp_uart_dma.h"
+#include "current_predict.h"
 #include "current_sense.h"
+#include "current_vec.h"
+#include "deadtime_comp.h"
+#include "dist_obs.h"
+#include "fault_mgr.h"
+#include "field_weaken.h"
 #include "foc_current_ctrl.h"
+#include "foc_pos_ctrl.h"
 #include "foc_speed_ctrl.h"
+#include "freq_resp.h"
 #include "host_cmd_app.h"
+#include "isr_timing.h"
 #include "justfloat.h"
 #include "motor_calib.h"
+#include "multiturn_pos.h"
 #include "mt6835.h"
 #include "mt6835_angle_corr.h"
+#include "rl_ident.h"
+#include "rls_est.h"
+#include "speed_ident.h"
+#include "s_curve_pos.h"
 #include "s_curve_vel.h"
+#include "speed_ff.h"
 #include "signal_log_sweep.h"
 #include "svpwm.h"
+#include "thermal_model.h"
 
 typedef struct
 {
@@ -65,8 +152,16 @@ typedef struct
     float pos_mech_rad;  /* measured mechanical angle, used by speed/calibration/logging */
     float theta_e_meas_rad;
     float theta_e_ctrl_rad;
+    float theta_ctrl_tcomp_s; // 控制电角度前馈补偿时间（取决于编码器读取方式）
     uint16_t enc_div_countdown;
     uint8_t enc_dma_enable; // 主循环读写MT6835寄存器时关闭ISR中断读取编码器，0=禁止
+    uint8_t enc_tim_trigger;       // 编码器读取由 TIM1 比较事件启动（同拍使用角度）
+    uint8_t enc_frame_expected;    // 上一拍已启动/预装 DMA 读取，本拍应收到一帧
+    uint8_t enc_status;            // 最近一帧有效数据的 STATUS[2:0]
+    uint16_t enc_bad_run;          // 连续无有效角度的 tick 数（外推中）
+    uint32_t enc_crc_err_count;    // CRC 错误帧数
+    uint32_t enc_status_rej_count; // CRC 正确但 STATUS 报警被丢弃的帧数
+    uint32_t enc_missing_count;    // 应到未到的帧数（DMA 未完成）
 
     uint16_t vbus_raw;
     float vbus_v;
@@ -81,6 +176,68 @@ typedef struct
     uint8_t i_offset_stage;
     uint8_t i_offset_ready;
     CurrentSensePair i_pair_active; // 当前采样通道组合
+    uint8_t i_adc_samples;          // 当前注入序列每通道转换次数（1/2/4）
+    uint8_t i_adc_ovs_enable;       // 按窗口长度自适应多次采样，0=固定单次
+    uint8_t pwm_ovm_enable;         // SVPWM 过调制开关（W1/W0）
+    uint8_t pwm_zs_mode;            // 零序注入方式 SvpwmZsMode（Z<n>）
+    uint8_t pwm_zs_active;          // DPWM 当前是否生效（按 |u| 迟滞切换）
+    DeadTimeComp dtc;               // 死区补偿（K<duty>）
+    DeadTimeIdent dtc_ident;        // 死区补偿幅值静止辨识（K）
+    RlIdent rl_ident;               // 静止 R/Ld/Lq 辨识（R）
+    float rl_tune_bw_hz;            // 辨识完成后电流环整定带宽
+    float motor_rs_ohm;             // 运行时电机参数（默认编译期值，R 命令辨识后更新）
+    float motor_ld_h;
+    float motor_lq_h;
+    float motor_ke_v_s;             // 反电动势常数（V/(rad/s)，机械），E1/E2 时在线更新
+    uint8_t dq_decouple_mode;       // dq 交叉耦合前馈：0 关，1 电流给定，2 实测电流（X）
+    float dbg_ud_dc_v;              // 本拍交叉耦合前馈 -we*Lq*iq
+    float dbg_uq_dc_v;              // 本拍交叉耦合前馈 we*Ld*id
+    FieldWeaken fw;                 // 电压反馈弱磁（N），fw.id_a 叠加到 Id 给定
+    CurrentVec ivec;                // 转矩需求 -> (Id, Iq)：MTPA 表 + 电流圆限幅（Y 切优先级）
+    volatile uint8_t ivec_rebuild_pending; // 电机参数变了，主循环重建 MTPA 表
+    uint8_t fw_enable;
+
+    RlsEst2 rls_elec;               // 在线 [R, Ke] 跟踪（E）
+    RlsEst2 rls_mech;               // 在线 [J/Kt, Tl/Kt] 跟踪
+    uint8_t rls_apply;              // 0 只估计，1 写 R/Ke，2 再写 J
+    float rls_r_ohm;
+    float rls_ke_v_s;
+    float rls_j_kgm2;
+    float rls_r_ref_ohm;            // 写入限幅的参考值：R 辨识/R0 时更新
+    float rls_ke_ref_v_s;           // Ke 参考值（编译期）
+    float rls_j_ref_kgm2;           // J 参考值：L 辨识/L0 时更新
+    uint16_t rls_win_tick;          // 中断窗口累加
+    float rls_acc_uq;
+    float rls_acc_id;
+    float rls_acc_iq;
+    float rls_acc_omega;
+    float rls_iq0_a;
+    float rls_omega0_rad_s;
+    float rls_u_mag_max_pu;
+    volatile uint8_t rls_win_ready; // 窗口结果待主循环处理
+    float rls_w_uq_v;
+    float rls_w_id_a;
+    float rls_w_iq_a;
+    float rls_w_omega_rad_s;
+    float rls_w_diq_a;
+    float rls_w_domega_rad_s;
+    float rls_w_u_mag_max_pu;
+
+    FreqResp fra;                   // 片上频率响应分析（H）
+    uint8_t fra_point;              // 当前注入点（中断内）
+    volatile uint8_t fra_request_pending;
+    uint8_t fra_request_point;
+    float fra_request_amp;
+    float fra_inj;                  // 本拍注入量
+    float fra_omega_ref_rad_s;      // 速度给定注入点的被测输入（含注入）
+    uint16_t fra_tx_idx;            // D24 下一个要发送的结果
+    uint8_t i_pair_valid_active;    // 当前采样组合两相窗口是否都够长
+    uint8_t i_predict_enable;       // 采样无效时用 dq 预测值代替，0=直接用原始采样
+    CurrentPredictDq i_predict;
+    uint32_t i_sample_meas_count; // 采样有效的 tick 数
+    uint32_t i_sample_pred_count; // 采样无效、用预测值的 tick 数
+    uint32_t i_sample_raw_count;  // 采样无效、仍用原始采样的 tick 数（预测关闭/不可用/超过连续上限）
+    uint16_t i_sample_bad_run;    // 电流环运行中连续原始无效采样的 tick 数（超过上限报 FAULT_SAMPLE_INVALID）
     float ia_a;
     float ib_a;
     float ic_a;
@@ -90,12 +247,27 @@ typedef struct
     float spd_omega_diff_rad_s;
     float spd_pll_theta_hat_rad;   // pll观测器估算角度
     float spd_pll_omega_int_rad_s; // pll观测器积分器
+    float spd_pll_kp;              // PLL 参数（默认编译期值，L 命令自整定后更新）
+    float spd_pll_ki;
     float spd_omega_pll_rad_s;     // pll观测器反馈速度
+    AngleObserver3 spd_ato;        // 三阶角度跟踪观测器（与 PLL 并行运行）
+    uint8_t spd_obs_mode;          // 速度反馈来源：0=PLL，1=三阶观测器（A0/A1）
 
     float i_trip_a;
-    uint8_t fault_overcurrent;
+    ThermalRc therm_motor; // I^2t 热模型：电机绕组（两阶）
+    ThermalRc therm_inv;   // I^2t 热模型：逆变器（一阶）
+    uint32_t therm_tick;
+    float therm_acc_i2;
+    float therm_i2_a2; // 最近一个热模型节拍的 |i|^2 均值
+    FaultMgr fault;            // 故障码/策略/历史环；锁存的故障 `I` 清除
+    uint8_t fault_tx_idx;      // D32 下一条要发送的历史记录（从新到旧）
+    BspOcpComp ocp;            // 硬件过流：COMP + DAC 门限 -> TIM1 BRK2
+    float ocp_trip_a;          // 硬件过流门限（A，Q 命令）
+    uint8_t ocp_enable;
+    volatile uint8_t ocp_pending; // 门限/使能变了，主循环（零偏就绪后）重写 DAC 并接入 BRK2
 
     uint32_t adc_isr_count;
+    IsrTiming isr_timing; // 控制中断截止时间监控（超时/丢拍计数、lateness 直方图）
     uint8_t dbg_calib_state;
     float dbg_theta_e;
     float dbg_theta_e_meas;
@@ -120,14 +292,47 @@ typedef struct
     uint8_t dbg_i_pair_valid;
     uint8_t dbg_i_valid_mask;
     uint8_t dbg_svm_sector;
+    uint8_t dbg_svm_ovm_region;
+    uint8_t dbg_svm_clamp_low;
     uint16_t dbg_i_low_window_a_ticks;
     uint16_t dbg_i_low_window_b_ticks;
     uint16_t dbg_i_low_window_c_ticks;
+    uint16_t dbg_i_pair_window_ticks;
+    uint8_t dbg_i_adc_samples;
 
     HostCmd last_host_cmd;
     uint32_t last_host_cmd_tick_ms;
 
     float target_pos_deg;
+
+    MultiTurnPos enc_mt;          // 多圈位置（原始编码器方向，校正后 raw21 累加）
+    uint8_t pos_loop_enabled;     // 位置模式（P）
+    uint16_t pos_loop_div_countdown;
+    int64_t pos_origin_count;     // 进入位置模式时的多圈计数，位置量都相对它
+    float pos_target_rad;         // 目标（相对起点，用户方向）
+    uint8_t pos_plan_pending;     // 新目标待规划（主循环）
+    float pos_ref_rad;            // 轨迹当前位置给定
+    float pos_ref_vel_rad_s;      // 轨迹当前速度（位置环速度前馈）
+    float pos_ref_acc_rad_s2;     // 轨迹当前加速度（Iq 前馈）
+    float pos_err_rad;
+    float pos_omega_ref_rad_s;    // 位置环输出 = 速度环给定
+    FocPosCtrl pos_ctrl;
+    SCurvePos pos_traj;           // 七段 S 曲线，中断推进
+    float pos_traj_base_rad;      // pos_traj 的起点
+    SCurvePos pos_traj_next;      // 主循环规划好、待中断接手的轨迹
+    float pos_traj_next_base_rad;
+    volatile uint8_t pos_traj_ready;
+    SpeedFf spd_ff;               // 速度环前馈系数（J/B/U 命令）
+    uint8_t spd_ff_enable;
+    float spd_iq_ff_a;            // 速度环 Iq 前馈（按给定轨迹的加速度/速度）
+    float spd_iq_pi_a;            // 速度环输出中 PI 的部分（= iq_ref - ff，含限幅）
+    float spd_omega_err_rad_s;
+    DistObs spd_dob;              // 负载转矩扰动观测器（名义 J/B）
+    uint8_t spd_dob_enable;       // 扰动补偿到 Iq（G0/G1）
+    float spd_iq_dob_a;           // 扰动补偿 Iq = Td_hat / Kt
+    SpeedIdent spd_ident;         // 加减速辨识 J/B/Tc（L）
+    float spd_tune_bw_hz;         // 辨识完成后速度环穿越频率
+    uint16_t spd_ident_div_countdown;
     float target_vel_rad_s;
     uint8_t calib_request;
     uint8_t calib_request_pending;
@@ -2,6 +2,48 @@
 
 static BspAdcInjPair *g_ctx = 0;
 
+static const uint32_t g_inj_ranks[BSP_ADC_INJ_PAIR_MAX_SAMPLES] = {
+    LL_ADC_INJ_RANK_1,
+    LL_ADC_INJ_RANK_2,
+    LL_ADC_INJ_RANK_3,
+    LL_ADC_INJ_RANK_4,
+};
+
+static uint8_t BspAdcInjPair_SanitizeSamples(uint8_t samples)
+{
+    if (samples >= 4U)
+    {
+        return 4U;
+    }
+    if (samples >= 2U)
+    {
+        return 2U;
+    }
+    return 1U;
+}
+
+/* 一次写入 JSQR：序列长度 + rank1..4 同一通道，避免多次 RMW 产生中间状态 */
+static void BspAdcInjPair_WriteJsqr(ADC_TypeDef *adc, uint32_t ch, uint8_t samples)
+{
+    const uint32_t ch_nb = __LL_ADC_CHANNEL_TO_DECIMAL_NB(ch);
+    const uint32_t mask = ADC_JSQR_JL | ADC_JSQR_JSQ1 | ADC_JSQR_JSQ2 | ADC_JSQR_JSQ3 | ADC_JSQR_JSQ4;
+    const uint32_t val = (((uint32_t)samples - 1U) << ADC_JSQR_JL_Pos) | (ch_nb << ADC_JSQR_JSQ1_Pos) |
+                         (ch_nb << ADC_JSQR_JSQ2_Pos) | (ch_nb << ADC_JSQR_JSQ3_Pos) | (ch_nb << ADC_JSQR_JSQ4_Pos);
+    MODIFY_REG(adc->JSQR, mask, val);
+}
+
+static uint16_t BspAdcInjPair_ReadSum(ADC_TypeDef *adc, uint8_t samples, uint8_t max_samples)
+{
+    uint32_t sum = 0U;
+    for (uint32_t i = 0U; i < (uint32_t)samples; ++i)
+    {
+        sum += LL_ADC_INJ_ReadConversionData32(adc, g_inj_ranks[i]);
+    }
+
+    /* 不同序列长度统一归一化到 max_samples 倍（samples 与 max_samples 均为 1/2/4） */
+    return (uint16_t)(sum * ((uint32_t)max_samples / (uint32_t)samples));
+}
+
 void BspAdcInjPair_Init(BspAdcInjPair *ctx, ADC_HandleTypeDef *hadc1, ADC_HandleTypeDef *hadc2)
 {
     if (ctx == 0)
@@ -13,6 +55,10 @@ void BspAdcInjPair_Init(BspAdcInjPair *ctx, ADC_HandleTypeDef *hadc1, ADC_Handle
     ctx->hadc2 = hadc2;
     ctx->adc1_ch = LL_ADC_CHANNEL_1;
     ctx->adc2_ch = LL_ADC_CHANNEL_7;
+    ctx->samples = 1U;
+    ctx->max_samples = 1U;
+    ctx->hw_ratio = 1U;
+    ctx->count_scale = 1U;
     ctx->last_adc1 = 0U;
     ctx->last_adc2 = 0U;
     ctx->have1 = 0U;
@@ -46,6 +92,70 @@ void BspAdcInjPair_RegisterCallback(BspAdcInjPair *ctx, void *user, BspAdcInjPai
     ctx->on_pair = on_pair;
 }
 
+/* 配置注入组过采样：
+ * - hw_ratio：G4 硬件注入过采样（JOVSE，右移 0，JDR 中为 hw_ratio 次转换之和），1=关闭；
+ *   CFGR2 只允许在 JADSTART=0 时修改，所以必须在 Start 之前调用。
+ * - max_samples：每个 PWM 周期注入序列最多重复转换次数（1/2/4），运行时可用 SetChannels 逐周期调整。
+ * 回调输出统一为 hw_ratio * max_samples 倍的 12bit 码值，上限 65535。 */
+HAL_StatusTypeDef BspAdcInjPair_ConfigOversampling(BspAdcInjPair *ctx, uint8_t hw_ratio, uint8_t max_samples)
+{
+    if ((ctx == 0) || (ctx->hadc1 == 0) || (ctx->hadc2 == 0) || (ctx->hadc1->Instance == 0) || (ctx->hadc2->Instance == 0))
+    {
+        return HAL_ERROR;
+    }
+
+    uint32_t ovs_ratio = 0U;
+    switch (hw_ratio)
+    {
+    case 1U:
+        break;
+    case 2U:
+        ovs_ratio = LL_ADC_OVS_RATIO_2;
+        break;
+    case 4U:
+        ovs_ratio = LL_ADC_OVS_RATIO_4;
+        break;
+    case 8U:
+        ovs_ratio = LL_ADC_OVS_RATIO_8;
+        break;
+    case 16U:
+        ovs_ratio = LL_ADC_OVS_RATIO_16;
+        break;
+    default:
+        return HAL_ERROR;
+    }
+
+    const uint8_t n_max = BspAdcInjPair_SanitizeSamples(max_samples);
+    if (((uint32_t)hw_ratio * (uint32_t)n_max) > 16U)
+    {
+        return HAL_ERROR;
+    }
+    if ((LL_ADC_INJ_IsConversionOngoing(ctx->hadc1->Instance) != 0U) ||
+        (LL_ADC_INJ_IsConversionOngoing(ctx->hadc2->Instance) != 0U))
+    {
+        return HAL_ERROR;
+    }
+
+    ADC_TypeDef *const adcs[2] = {ctx->hadc1->Instance, ctx->hadc2->Instance};
+    for (uint32_t i = 0U; i < 2U; ++i)
+    {
+        if (hw_ratio > 1U)
+        {
+            LL_ADC_ConfigOverSamplingRatioShift(adcs[i], ovs_ratio, LL_ADC_OVS_SHIFT_NONE);
+            LL_ADC_SetOverSamplingScope(adcs[i], LL_ADC_OVS_GRP_INJECTED);
+        }
+        else
+        {
+            LL_ADC_SetOverSamplingScope(adcs[i], LL_ADC_OVS_DISABLE);
+        }
+    }
+
+    ctx->hw_ratio = hw_ratio;
+    ctx->max_samples = n_max;
+    ctx->count_scale = (uint8_t)(hw_ratio * n_max);
+    return HAL_OK;
+}
+
 HAL_StatusTypeDef BspAdcInjPair_Start(BspAdcInjPair *ctx)
 {
     if ((ctx == 0) || (ctx->hadc1 == 0) || (ctx->hadc2 == 0))
@@ -61,10 +171,20 @@ HAL_StatusTypeDef BspAdcInjPair_Start(BspAdcInjPair *ctx)
     {
         return HAL_ERROR;
     }
+    /*
+     * 注入序列可能多于 1 个 rank：只在序列结束(JEOS)时进回调。
+     * 不改 Init.EOCSelection（规则组 Vbus 的 PollForConversion 按它等 EOC/EOS），InjectedStart_IT 按它打开 JEOC，
+     * 这里再把注入中断换成 JEOS。TIM1 触发已在跑，换之前先屏蔽 ADC1_2 中断，免得在 rank1 的 JEOC 上进回调读到半个序列。
+     */
+    HAL_NVIC_DisableIRQ(ADC1_2_IRQn);
     if (HAL_ADCEx_InjectedStart_IT(ctx->hadc1) != HAL_OK)
     {
+        HAL_NVIC_EnableIRQ(ADC1_2_IRQn);
         return HAL_ERROR;
     }
+    __HAL_ADC_DISABLE_IT(ctx->hadc1, ADC_IT_JEOC);
+    __HAL_ADC_ENABLE_IT(ctx->hadc1, ADC_IT_JEOS);
+    HAL_NVIC_EnableIRQ(ADC1_2_IRQn);
 
     return HAL_OK;
 }
@@ -84,6 +204,33 @@ void BspAdcInjPair_SetRank1Channels(BspAdcInjPair *ctx, uint32_t adc1_ch, uint32
     LL_ADC_INJ_SetSequencerRanks(ctx->hadc2->Instance, LL_ADC_INJ_RANK_1, adc2_ch);
 }
 
+/* 修改 JSQR：pair 通道 + 本周期同一通道重复转换次数（下一次 TRGO2 生效） */
+void BspAdcInjPair_SetChannels(BspAdcInjPair *ctx, uint32_t adc1_ch, uint32_t adc2_ch, uint8_t samples)
+{
+    if ((ctx == 0) || (ctx->hadc1 == 0) || (ctx->hadc2 == 0) || (ctx->hadc1->Instance == 0) || (ctx->hadc2->Instance == 0))
+    {
+        return;
+    }
+
+    uint8_t n = BspAdcInjPair_SanitizeSamples(samples);
+    if (n > ctx->max_samples)
+    {
+        n = ctx->max_samples;
+    }
+
+    ctx->adc1_ch = adc1_ch;
+    ctx->adc2_ch = adc2_ch;
+    ctx->samples = n;
+
+    BspAdcInjPair_WriteJsqr(ctx->hadc1->Instance, adc1_ch, n);
+    BspAdcInjPair_WriteJsqr(ctx->hadc2->Instance, adc2_ch, n);
+}
+
+uint8_t BspAdcInjPair_CountScale(const BspAdcInjPair *ctx)
+{
+    return (ctx != 0) ? ctx->count_scale : 1U;
+}
+
 uint32_t BspAdcInjPair_Adc1Ch(const BspAdcInjPair *ctx)
 {
     return (ctx != 0) ? ctx->adc1_ch : 0U;
@@ -94,6 +241,22 @@ uint32_t BspAdcInjPair_Adc2Ch(const BspAdcInjPair *ctx)
     return (ctx != 0) ? ctx->adc2_ch : 0U;
 }
 
+/* 在 on_pair 里（退出前）调用：本次回调期间又完成了一次注入序列，或注入队列溢出，返回 1（这次转换的数据会被丢掉） */
+uint8_t BspAdcInjPair_PollOverrun(const BspAdcInjPair *ctx)
+{
+    if ((ctx == 0) || (ctx->hadc1 == 0) || (ctx->hadc1->Instance == 0))
+    {
+        return 0U;
+    }
+    ADC_TypeDef *adc = ctx->hadc1->Instance;
+    const uint32_t isr = adc->ISR;
+    if ((isr & ADC_ISR_JQOVF) != 0U)
+    {
+        adc->ISR = ADC_ISR_JQOVF;
+    }
+    return ((isr & (ADC_ISR_JEOS | ADC_ISR_JQOVF)) != 0U) ? 1U : 0U;
+}
+
 void HAL_ADCEx_InjectedConvCpltCallback(ADC_HandleTypeDef *hadc)
 {
     if ((g_ctx == 0) || (hadc == 0))
@@ -111,8 +274,20 @@ void HAL_ADCEx_InjectedConvCpltCallback(ADC_HandleTypeDef *hadc)
         return;
     }
 
-    g_ctx->last_adc1 = (uint16_t)HAL_ADCEx_InjectedGetValue(g_ctx->hadc1, ADC_INJECTED_RANK_1);
-    g_ctx->last_adc2 = (uint16_t)HAL_ADCEx_InjectedGetValue(g_ctx->hadc2, ADC_INJECTED_RANK_1);
+    /* samples 仍是上一拍写入 JSQR 的序列长度，即本次转换实际使用的长度 */
+    if (g_ctx->max_samples > 1U)
+    {
+        g_ctx->last_adc1 = BspAdcInjPair_ReadSum(g_ctx->hadc1->Instance, g_ctx->samples, g_ctx->max_samples);
+        g_ctx->last_adc2 = BspAdcInjPair_ReadSum(g_ctx->hadc2->Instance, g_ctx->samples, g_ctx->max_samples);
+    }
+    else
+    {
+        g_ctx->last_adc1 = (uint16_t)HAL_ADCEx_InjectedGetValue(g_ctx->hadc1, ADC_INJECTED_RANK_1);
+        g_ctx->last_adc2 = (uint16_t)HAL_ADCEx_InjectedGetValue(g_ctx->hadc2, ADC_INJECTED_RANK_1);
+    }
+
+    /* HAL 在回调返回后才清 JEOC/JEOS：先清掉，回调期间再完成一次序列时标志会重新置位（BspAdcInjPair_PollOverrun） */
+    g_ctx->hadc1->Instance->ISR = ADC_ISR_JEOC | ADC_ISR_JEOS;
 
     if (g_ctx->on_pair != 0)
     {
@@ -6,6 +6,10 @@
 
 #include <stdint.h>
 
+/* 注入序列最多 4 个 rank：同一通道重复 1/2/4 次，ISR 中求和 */
+#define BSP_ADC_INJ_PAIR_MAX_SAMPLES (4U)
+
+/* adc1/adc2 为归一化到 count_scale 的求和值（count_scale=1 时即原始 12bit 码值） */
 typedef void (*BspAdcInjPair_OnPair)(void *user, uint16_t adc1, uint16_t adc2);
 
 typedef struct
@@ -16,6 +20,11 @@ typedef struct
     uint32_t adc1_ch;
     uint32_t adc2_ch;
 
+    uint8_t samples;     /* 当前注入序列长度（同一通道重复次数）：1/2/4 */
+    uint8_t max_samples; /* 序列长度上限，决定求和结果的归一化倍数 */
+    uint8_t hw_ratio;    /* 硬件注入过采样倍数（1=关闭），只能在 Start 之前配置 */
+    uint8_t count_scale; /* hw_ratio * max_samples：回调输出相对 12bit 码值的倍数 */
+
     volatile uint16_t last_adc1;
     volatile uint16_t last_adc2;
     volatile uint8_t have1;
@@ -28,11 +37,16 @@ typedef struct
 void BspAdcInjPair_Init(BspAdcInjPair *ctx, ADC_HandleTypeDef *hadc1, ADC_HandleTypeDef *hadc2);
 void BspAdcInjPair_RegisterCallback(BspAdcInjPair *ctx, void *user, BspAdcInjPair_OnPair on_pair);
 
+HAL_StatusTypeDef BspAdcInjPair_ConfigOversampling(BspAdcInjPair *ctx, uint8_t hw_ratio, uint8_t max_samples);
 HAL_StatusTypeDef BspAdcInjPair_Start(BspAdcInjPair *ctx);
 
 void BspAdcInjPair_SetRank1Channels(BspAdcInjPair *ctx, uint32_t adc1_ch, uint32_t adc2_ch);
+void BspAdcInjPair_SetChannels(BspAdcInjPair *ctx, uint32_t adc1_ch, uint32_t adc2_ch, uint8_t samples);
+uint8_t BspAdcInjPair_CountScale(const BspAdcInjPair *ctx);
 uint32_t BspAdcInjPair_Adc1Ch(const BspAdcInjPair *ctx);
 uint32_t BspAdcInjPair_Adc2Ch(const BspAdcInjPair *ctx);
+/* 回调期间又完成一次注入序列 / 注入队列溢出（控制中断超时） */
+uint8_t BspAdcInjPair_PollOverrun(const BspAdcInjPair *ctx);
 
 #endif /* BSP_ADC_INJ_PAIR_H */
 
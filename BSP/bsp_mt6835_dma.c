@@ -5,6 +5,64 @@
 
 static BspMt6835Dma *g_ctx = 0;
 
+static void BspMt6835Dma_CsHigh(const BspMt6835Dma *ctx)
+{
+    ctx->cs_port->BSRR = (uint32_t)ctx->cs_pin;
+}
+
+static void BspMt6835Dma_CsLow(const BspMt6835Dma *ctx)
+{
+    ctx->cs_port->BSRR = (uint32_t)ctx->cs_pin << 16U;
+}
+
+#if (BSP_MT6835_DMA_USE_REG != 0U)
+/*
+ * 一次性配好 SPI3 RX/TX 两个 DMA 通道（方向/位宽/优先级沿用 CubeMX 的 HAL_DMA_Init 结果）：
+ * CPAR=SPI->DR，CMAR=rx/tx 缓冲，只开 RX 通道的 TC/TE 中断。之后每次启动只写 CNDTR 和 EN。
+ * MT6835 的 CS 在 PD2，不是 SPI3 的硬件 NSS 引脚，所以 CS 仍由软件 BSRR 控制。
+ */
+static void BspMt6835Dma_RegInit(BspMt6835Dma *ctx)
+{
+    ctx->spi = 0;
+    ctx->dma_rx = 0;
+    ctx->dma_tx = 0;
+    if ((ctx->hspi == 0) || (ctx->hspi->Instance == 0) || (ctx->hspi->hdmarx == 0) || (ctx->hspi->hdmatx == 0))
+    {
+        return;
+    }
+
+    SPI_TypeDef *spi = ctx->hspi->Instance;
+    DMA_HandleTypeDef *hrx = ctx->hspi->hdmarx;
+    DMA_HandleTypeDef *htx = ctx->hspi->hdmatx;
+    DMA_Channel_TypeDef *rx = hrx->Instance;
+    DMA_Channel_TypeDef *tx = htx->Instance;
+
+    rx->CCR &= ~DMA_CCR_EN;
+    tx->CCR &= ~DMA_CCR_EN;
+    rx->CPAR = (uint32_t)&spi->DR;
+    rx->CMAR = (uint32_t)ctx->rx;
+    tx->CPAR = (uint32_t)&spi->DR;
+    tx->CMAR = (uint32_t)ctx->tx;
+    rx->CCR = (rx->CCR & ~(DMA_CCR_HTIE | DMA_CCR_TCIE | DMA_CCR_TEIE)) | (DMA_CCR_TCIE | DMA_CCR_TEIE);
+    tx->CCR &= ~(DMA_CCR_HTIE | DMA_CCR_TCIE | DMA_CCR_TEIE);
+
+    ctx->dma_rx_base = hrx->DmaBaseAddress;
+    ctx->dma_tx_base = htx->DmaBaseAddress;
+    ctx->dma_rx_shift = hrx->ChannelIndex & 0x1FU;
+    ctx->dma_tx_shift = htx->ChannelIndex & 0x1FU;
+    ctx->dma_rx_base->IFCR = (DMA_ISR_GIF1 << ctx->dma_rx_shift);
+    ctx->dma_tx_base->IFCR = (DMA_ISR_GIF1 << ctx->dma_tx_shift);
+
+    /* 8 位帧：RXNE 门限 1 字节；RX 请求常开（通道关闭时请求被忽略，不影响 BspSpi3Fast 轮询） */
+    spi->CR2 |= (SPI_CR2_FRXTH | SPI_CR2_RXDMAEN);
+    spi->CR1 |= SPI_CR1_SPE;
+
+    ctx->spi = spi;
+    ctx->dma_rx = rx;
+    ctx->dma_tx = tx;
+}
+#endif
+
 void BspMt6835Dma_Init(BspMt6835Dma *ctx, SPI_HandleTypeDef *hspi, GPIO_TypeDef *cs_port, uint16_t cs_pin)
 {
     if (ctx == 0)
@@ -24,12 +82,19 @@ void BspMt6835Dma_Init(BspMt6835Dma *ctx, SPI_HandleTypeDef *hspi, GPIO_TypeDef
     ctx->tx[2] = 0x00U;
     ctx->tx[3] = 0x00U;
     ctx->tx[4] = 0x00U;
+    ctx->tx[5] = 0x00U;
+    ctx->trig_tim = 0;
+    ctx->trig_dma = 0;
 
     if (ctx->cs_port != 0)
     {
-        HAL_GPIO_WritePin(ctx->cs_port, ctx->cs_pin, GPIO_PIN_SET);
+        BspMt6835Dma_CsHigh(ctx);
     }
 
+#if (BSP_MT6835_DMA_USE_REG != 0U)
+    BspMt6835Dma_RegInit(ctx);
+#endif
+
     g_ctx = ctx;
 }
 
@@ -46,16 +111,99 @@ uint8_t BspMt6835Dma_TryStart(BspMt6835Dma *ctx)
 
     ctx->busy = 1U;
 
-    HAL_GPIO_WritePin(ctx->cs_port, ctx->cs_pin, GPIO_PIN_RESET);
+    BspMt6835Dma_CsLow(ctx);
 
+#if (BSP_MT6835_DMA_USE_REG != 0U)
+    if (ctx->dma_rx == 0)
+    {
+        BspMt6835Dma_CsHigh(ctx);
+        ctx->busy = 0U;
+        return 0U;
+    }
+    /* 重装计数并使能：先 RX 后 TX，最后打开 TX 请求（TXE=1 时立即开始搬运） */
+    ctx->dma_rx->CNDTR = BSP_MT6835_DMA_XFER_LEN;
+    ctx->dma_tx->CNDTR = BSP_MT6835_DMA_XFER_LEN;
+    ctx->dma_rx->CCR |= DMA_CCR_EN;
+    ctx->dma_tx->CCR |= DMA_CCR_EN;
+    ctx->spi->CR2 |= SPI_CR2_TXDMAEN;
+#else
     /* spi总线工作给dma，解放cpu */
     if (HAL_SPI_TransmitReceive_DMA(ctx->hspi, ctx->tx, ctx->rx, (uint16_t)sizeof(ctx->tx)) != HAL_OK)
     {
-        HAL_GPIO_WritePin(ctx->cs_port, ctx->cs_pin, GPIO_PIN_SET);
+        BspMt6835Dma_CsHigh(ctx);
         ctx->busy = 0U;
         return 0U;
     }
+#endif
+
+    return 1U;
+}
+
+/*
+ * 配置定时器触发的读取（需寄存器直驱路径）：dma/dmamux 为一个空闲 DMA 通道，request 为 TIM 比较事件的 DMAMUX 请求号。
+ * 该通道每次搬 1 个字（trig_cr2 -> SPI->CR2），不开中断。成功返回 1。
+ */
+uint8_t BspMt6835Dma_ConfigTimerTrigger(BspMt6835Dma *ctx, TIM_TypeDef *tim, uint32_t dier_de, DMA_Channel_TypeDef *dma,
+                                        DMAMUX_Channel_TypeDef *dmamux, uint32_t request)
+{
+#if (BSP_MT6835_DMA_USE_REG != 0U)
+    if ((ctx == 0) || (ctx->spi == 0) || (tim == 0) || (dma == 0) || (dmamux == 0))
+    {
+        return 0U;
+    }
 
+    tim->DIER &= ~dier_de;
+    dma->CCR = 0U;
+    dmamux->CCR = request & DMAMUX_CxCR_DMAREQ_ID;
+
+    ctx->trig_cr2 = ctx->spi->CR2 | SPI_CR2_TXDMAEN;
+    dma->CPAR = (uint32_t)&ctx->spi->CR2;
+    dma->CMAR = (uint32_t)&ctx->trig_cr2;
+    dma->CCR = DMA_CCR_DIR | DMA_CCR_PSIZE_1 | DMA_CCR_MSIZE_1 | DMA_CCR_PL;
+
+    ctx->trig_tim = tim;
+    ctx->trig_dier_de = dier_de;
+    ctx->trig_dma = dma;
+    return 1U;
+#else
+    (void)ctx;
+    (void)tim;
+    (void)dier_de;
+    (void)dma;
+    (void)dmamux;
+    (void)request;
+    return 0U;
+#endif
+}
+
+/*
+ * 预装一次定时器触发的读取：拉低 CS、重装 RX/TX 通道并使能，但不置 TXDMAEN，
+ * 等下一个 TIM 比较事件由触发通道写 CR2 启动。CCxDE 只在预装期间打开，避免空闲周期积压请求。
+ */
+uint8_t BspMt6835Dma_Arm(BspMt6835Dma *ctx)
+{
+    if ((ctx == 0) || (ctx->trig_dma == 0) || (ctx->cs_port == 0))
+    {
+        return 0U;
+    }
+    if (ctx->busy != 0U)
+    {
+        return 0U;
+    }
+
+    ctx->busy = 1U;
+
+    BspMt6835Dma_CsLow(ctx);
+
+    ctx->dma_rx->CNDTR = BSP_MT6835_DMA_XFER_LEN;
+    ctx->dma_tx->CNDTR = BSP_MT6835_DMA_XFER_LEN;
+    ctx->dma_rx->CCR |= DMA_CCR_EN;
+    ctx->dma_tx->CCR |= DMA_CCR_EN;
+
+    ctx->trig_dma->CCR &= ~DMA_CCR_EN;
+    ctx->trig_dma->CNDTR = 1U;
+    ctx->trig_dma->CCR |= DMA_CCR_EN;
+    ctx->trig_tim->DIER |= ctx->trig_dier_de;
     return 1U;
 }
 
@@ -76,6 +224,26 @@ uint8_t BspMt6835Dma_PopRaw21(BspMt6835Dma *ctx, uint32_t *raw21_out)
     return 1U;
 }
 
+/* 取出完整角度帧（含 STATUS 与 CRC），与 PopRaw21 共用同一个 have 标志 */
+uint8_t BspMt6835Dma_PopFrame(BspMt6835Dma *ctx, uint8_t frame_out[BSP_MT6835_DMA_FRAME_LEN])
+{
+    if ((ctx == 0) || (frame_out == 0))
+    {
+        return 0U;
+    }
+    if (ctx->have_raw21 == 0U)
+    {
+        return 0U;
+    }
+
+    for (uint32_t i = 0U; i < BSP_MT6835_DMA_FRAME_LEN; ++i)
+    {
+        frame_out[i] = ctx->frame[i];
+    }
+    ctx->have_raw21 = 0U;
+    return 1U;
+}
+
 static void BspMt6835Dma_OnDone(BspMt6835Dma *ctx)
 {
     if ((ctx == 0) || (ctx->cs_port == 0))
@@ -83,12 +251,16 @@ static void BspMt6835Dma_OnDone(BspMt6835Dma *ctx)
         return;
     }
 
-    HAL_GPIO_WritePin(ctx->cs_port, ctx->cs_pin, GPIO_PIN_SET);
+    BspMt6835Dma_CsHigh(ctx);
 
     const uint8_t b20_13 = ctx->rx[2];
     const uint8_t b12_5 = ctx->rx[3];
     const uint8_t b4_0_status = ctx->rx[4];
     ctx->raw21 = (((uint32_t)b20_13 << 13) | ((uint32_t)b12_5 << 5) | ((uint32_t)b4_0_status >> 3)) & 0x1FFFFFU;
+    ctx->frame[0] = b20_13;
+    ctx->frame[1] = b12_5;
+    ctx->frame[2] = b4_0_status;
+    ctx->frame[3] = ctx->rx[5];
     ctx->have_raw21 = 1U;
     ctx->busy = 0U;
 }
@@ -100,10 +272,46 @@ static void BspMt6835Dma_OnError(BspMt6835Dma *ctx)
         return;
     }
 
-    HAL_GPIO_WritePin(ctx->cs_port, ctx->cs_pin, GPIO_PIN_SET);
+    BspMt6835Dma_CsHigh(ctx);
     ctx->busy = 0U;
 }
 
+uint8_t BspMt6835Dma_RxDmaIrq(void)
+{
+#if (BSP_MT6835_DMA_USE_REG != 0U)
+    BspMt6835Dma *ctx = g_ctx;
+    if ((ctx == 0) || (ctx->dma_rx == 0))
+    {
+        return 0U;
+    }
+
+    const uint32_t isr = ctx->dma_rx_base->ISR;
+    ctx->dma_rx_base->IFCR = (DMA_ISR_GIF1 << ctx->dma_rx_shift);
+
+    /* 收完最后一个字节即传输结束：关通道和 TX 请求，为下次重装 CNDTR 做准备 */
+    ctx->spi->CR2 &= ~SPI_CR2_TXDMAEN;
+    if (ctx->trig_tim != 0)
+    {
+        ctx->trig_tim->DIER &= ~ctx->trig_dier_de;
+    }
+    ctx->dma_rx->CCR &= ~DMA_CCR_EN;
+    ctx->dma_tx->CCR &= ~DMA_CCR_EN;
+    ctx->dma_tx_base->IFCR = (DMA_ISR_GIF1 << ctx->dma_tx_shift);
+
+    if ((isr & (DMA_ISR_TEIF1 << ctx->dma_rx_shift)) != 0U)
+    {
+        BspMt6835Dma_OnError(ctx);
+    }
+    else if ((isr & (DMA_ISR_TCIF1 << ctx->dma_rx_shift)) != 0U)
+    {
+        BspMt6835Dma_OnDone(ctx);
+    }
+    return 1U;
+#else
+    return 0U;
+#endif
+}
+
 /* spi工作结束，弱函数回调，交给cpu做比特位拼凑工作 */
 void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi)
 {
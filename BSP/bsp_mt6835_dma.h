@@ -6,23 +6,54 @@
 
 #include <stdint.h>
 
+#ifndef BSP_MT6835_DMA_USE_REG
+/* 1: 寄存器直驱（DMA 通道初始化时配好，每次只写 CNDTR/EN，CS 走 BSRR，完成中断不经 HAL）；0: HAL_SPI_TransmitReceive_DMA */
+#define BSP_MT6835_DMA_USE_REG (1U)
+#endif
+
+/* 2 字节读命令 + 3 字节角度/状态 + 1 字节 CRC */
+#define BSP_MT6835_DMA_XFER_LEN (6U)
+#define BSP_MT6835_DMA_FRAME_LEN (4U)
+
 typedef struct
 {
     SPI_HandleTypeDef *hspi;
     GPIO_TypeDef *cs_port;
     uint16_t cs_pin;
 
-    uint8_t tx[5];
-    uint8_t rx[5];
+    uint8_t tx[BSP_MT6835_DMA_XFER_LEN];
+    uint8_t rx[BSP_MT6835_DMA_XFER_LEN];
 
     volatile uint8_t busy;
     volatile uint8_t have_raw21;
     volatile uint32_t raw21;
+    uint8_t frame[BSP_MT6835_DMA_FRAME_LEN]; /* rx[2..5] 原样拷贝，CRC/状态由上层解析 */
+
+    /* 寄存器直驱路径：Init 时从 HAL 句柄取出，之后 ISR 里不再碰 HAL */
+    SPI_TypeDef *spi;
+    DMA_Channel_TypeDef *dma_rx;
+    DMA_Channel_TypeDef *dma_tx;
+    DMA_TypeDef *dma_rx_base;
+    DMA_TypeDef *dma_tx_base;
+    uint32_t dma_rx_shift; /* 通道在 ISR/IFCR 中的位偏移（HAL ChannelIndex） */
+    uint32_t dma_tx_shift;
+
+    /* 定时器触发：TIM 比较事件的 DMA 请求把 trig_cr2（含 TXDMAEN）写进 SPI->CR2，SPI 在该时刻开始时钟 */
+    TIM_TypeDef *trig_tim;
+    uint32_t trig_dier_de; /* TIMx_DIER 中对应的 CCxDE 位 */
+    DMA_Channel_TypeDef *trig_dma;
+    uint32_t trig_cr2;
 } BspMt6835Dma;
 
 void BspMt6835Dma_Init(BspMt6835Dma *ctx, SPI_HandleTypeDef *hspi, GPIO_TypeDef *cs_port, uint16_t cs_pin);
 uint8_t BspMt6835Dma_TryStart(BspMt6835Dma *ctx);
+uint8_t BspMt6835Dma_ConfigTimerTrigger(BspMt6835Dma *ctx, TIM_TypeDef *tim, uint32_t dier_de, DMA_Channel_TypeDef *dma,
+                                        DMAMUX_Channel_TypeDef *dmamux, uint32_t request);
+uint8_t BspMt6835Dma_Arm(BspMt6835Dma *ctx);
 uint8_t BspMt6835Dma_PopRaw21(BspMt6835Dma *ctx, uint32_t *raw21_out);
+uint8_t BspMt6835Dma_PopFrame(BspMt6835Dma *ctx, uint8_t frame_out[BSP_MT6835_DMA_FRAME_LEN]);
+/* 在 SPI3 RX DMA 通道中断入口调用：返回 1 表示已处理（寄存器路径），调用方直接返回；0 交给 HAL */
+uint8_t BspMt6835Dma_RxDmaIrq(void);
 
 #endif /* BSP_MT6835_DMA_H */
 
@@ -0,0 +1,208 @@
+#include "bsp_ocp_comp.h"
+
+#define BSP_OCP_COMP_DAC_WAIT_MAX (20000U)
+
+static void BspOcpComp_DacWrite(DAC_TypeDef *dac, uint8_t dac_ch, uint16_t code)
+{
+    if (dac_ch == 2U)
+    {
+        dac->DHR12R2 = code;
+    }
+    else
+    {
+        dac->DHR12R1 = code;
+    }
+}
+
+/*
+ * DAC 通道只接片内外设（MCR.MODE = 011：内部连接、无输出缓冲），上电先写门限再使能，不会出现 0V 门限的瞬间。
+ * HCLK > 80MHz 时 DAC 接口要开 HFSEL（> 160MHz 用 10）。
+ */
+static void BspOcpComp_DacInit(DAC_TypeDef *dac, uint8_t dac_ch, uint16_t code)
+{
+    if (dac == DAC1)
+    {
+        RCC->AHB2ENR |= RCC_AHB2ENR_DAC1EN;
+    }
+    else
+    {
+        RCC->AHB2ENR |= RCC_AHB2ENR_DAC3EN;
+    }
+    (void)RCC->AHB2ENR;
+
+    const uint32_t hfsel = (SystemCoreClock > 160000000U) ? DAC_MCR_HFSEL_1
+                                                          : ((SystemCoreClock > 80000000U) ? DAC_MCR_HFSEL_0 : 0U);
+    const uint32_t shift = (dac_ch == 2U) ? 16U : 0U;
+    const uint32_t en = DAC_CR_EN1 << shift;
+    const uint32_t rdy = DAC_SR_DAC1RDY << shift;
+
+    dac->CR &= ~en;
+    dac->MCR = (dac->MCR & ~(DAC_MCR_HFSEL | (DAC_MCR_MODE1 << shift))) | hfsel |
+               ((DAC_MCR_MODE1_1 | DAC_MCR_MODE1_0) << shift);
+    BspOcpComp_DacWrite(dac, dac_ch, code);
+    dac->CR |= en;
+    for (uint32_t i = 0U; (i < BSP_OCP_COMP_DAC_WAIT_MAX) && ((dac->SR & rdy) == 0U); ++i)
+    {
+    }
+}
+
+void BspOcpComp_Init(BspOcpComp *ctx, TIM_TypeDef *tim, const BspOcpCompChannel *ch, uint8_t n_ch,
+                     uint32_t brk2_filter)
+{
+    if (ctx == 0)
+    {
+        return;
+    }
+    ctx->tim = 0;
+    ctx->ch = 0;
+    ctx->n_ch = 0U;
+    ctx->ready = 0U;
+    ctx->armed = 0U;
+    if ((tim == 0) || (ch == 0) || (n_ch == 0U) || (n_ch > BSP_OCP_COMP_MAX_CH) || ((tim->BDTR & TIM_BDTR_MOE) != 0U))
+    {
+        return;
+    }
+
+    /* COMP 挂在 SYSCFG 时钟下 */
+    RCC->APB2ENR |= RCC_APB2ENR_SYSCFGEN;
+    (void)RCC->APB2ENR;
+
+    for (uint8_t i = 0U; i < n_ch; ++i)
+    {
+        const BspOcpCompChannel *c = &ch[i];
+        if ((c->comp->CSR & COMP_CSR_LOCK) != 0U)
+        {
+            return;
+        }
+        /* 默认门限放满量程（不翻转），门限由上层在零偏就绪后给出 */
+        ctx->dac_code[i] = (c->invert != 0U) ? 0U : 4095U;
+        BspOcpComp_DacInit(c->dac, c->dac_ch, ctx->dac_code[i]);
+
+        uint32_t csr = ((c->inpsel << COMP_CSR_INPSEL_Pos) & COMP_CSR_INPSEL) |
+                       ((c->inmsel << COMP_CSR_INMSEL_Pos) & COMP_CSR_INMSEL) |
+                       (((uint32_t)BSP_OCP_COMP_HYST << COMP_CSR_HYST_Pos) & COMP_CSR_HYST);
+        if (c->invert != 0U)
+        {
+            csr |= COMP_CSR_POLARITY;
+        }
+        c->comp->CSR = csr;
+        c->comp->CSR = csr | COMP_CSR_EN;
+    }
+
+    /*
+     * BRK2：高电平有效（比较器输出 = 故障），数字滤波吃掉开关振铃；比较器源在 Arm 时才接进来。
+     * MOE=0 时写 BDTR，不会和硬件清 MOE 竞争。
+     */
+    tim->AF2 &= ~(TIM1_AF2_BK2INE | TIM1_AF2_BK2CMP1E | TIM1_AF2_BK2CMP2E | TIM1_AF2_BK2CMP3E | TIM1_AF2_BK2CMP4E);
+    tim->BDTR = (tim->BDTR & ~TIM_BDTR_BK2F) | ((brk2_filter << TIM_BDTR_BK2F_Pos) & TIM_BDTR_BK2F) | TIM_BDTR_BK2P |
+                TIM_BDTR_BK2E;
+    tim->SR = (uint32_t)~(TIM_SR_BIF | TIM_SR_B2IF);
+
+    ctx->tim = tim;
+    ctx->ch = ch;
+    ctx->n_ch = n_ch;
+    ctx->ready = 1U;
+}
+
+/* 12 位 DAC 码值（与 ADC 同一 VREF+），运行中可改，写 DHR 立即生效 */
+void BspOcpComp_SetThreshold(BspOcpComp *ctx, uint8_t idx, uint16_t dac_code)
+{
+    if ((ctx == 0) || (ctx->ready == 0U) || (idx >= ctx->n_ch))
+    {
+        return;
+    }
+    const uint16_t code = (dac_code > 4095U) ? 4095U : dac_code;
+    ctx->dac_code[idx] = code;
+    BspOcpComp_DacWrite(ctx->ch[idx].dac, ctx->ch[idx].dac_ch, code);
+}
+
+uint8_t BspOcpComp_Active(const BspOcpComp *ctx)
+{
+    if ((ctx == 0) || (ctx->ready == 0U))
+    {
+        return 0U;
+    }
+    for (uint8_t i = 0U; i < ctx->n_ch; ++i)
+    {
+        /* VALUE 已经过 POLARITY，1 即故障电平 */
+        if ((ctx->ch[i].comp->CSR & COMP_CSR_VALUE) != 0U)
+        {
+            return 1U;
+        }
+    }
+    return 0U;
+}
+
+/* 门限设好后接入 BRK2；比较器此刻就在故障电平（门限不对或电流没回零）时不接，返回 0 */
+uint8_t BspOcpComp_Arm(BspOcpComp *ctx)
+{
+    if ((ctx == 0) || (ctx->ready == 0U) || (BspOcpComp_Active(ctx) != 0U))
+    {
+        return 0U;
+    }
+    uint32_t en = 0U;
+    for (uint8_t i = 0U; i < ctx->n_ch; ++i)
+    {
+        en |= ctx->ch[i].af2_en;
+    }
+    ctx->tim->SR = (uint32_t)~TIM_SR_B2IF;
+    ctx->tim->AF2 |= en;
+    ctx->armed = 1U;
+    return 1U;
+}
+
+void BspOcpComp_Disarm(BspOcpComp *ctx)
+{
+    if ((ctx == 0) || (ctx->ready == 0U))
+    {
+        return;
+    }
+    uint32_t en = 0U;
+    for (uint8_t i = 0U; i < ctx->n_ch; ++i)
+    {
+        en |= ctx->ch[i].af2_en;
+    }
+    ctx->tim->AF2 &= ~en;
+    ctx->armed = 0U;
+}
+
+/*
+ * break 事件必然同时清 MOE（AOE 关闭）；输出关着时 BKIN 抖动留下的旧标志在下次置 MOE 后不算故障，
+ * 所以只认"标志置位且 MOE 已被清"的组合。
+ */
+uint8_t BspOcpComp_PollTrip(const BspOcpComp *ctx)
+{
+    if ((ctx == 0) || (ctx->ready == 0U) || ((ctx->tim->BDTR & TIM_BDTR_MOE) != 0U))
+    {
+        return 0U;
+    }
+    const uint32_t sr = ctx->tim->SR;
+    uint8_t trip = 0U;
+    if ((sr & TIM_SR_B2IF) != 0U)
+    {
+        trip |= BSP_OCP_COMP_TRIP_BRK2;
+    }
+    if ((sr & TIM_SR_BIF) != 0U)
+    {
+        trip |= BSP_OCP_COMP_TRIP_BRK;
+    }
+    return trip;
+}
+
+/*
+ * 重新上电顺序：MOE 保持 0 -> 确认比较器已回落 -> 清 BIF/B2IF（break 输入仍有效时硬件不让清，再读一次确认）。
+ * 之后由 BspTim1Pwm_EnableOutputs 正常置 MOE。
+ */
+uint8_t BspOcpComp_Rearm(BspOcpComp *ctx)
+{
+    if ((ctx == 0) || (ctx->ready == 0U))
+    {
+        return 1U;
+    }
+    if (((ctx->tim->BDTR & TIM_BDTR_MOE) != 0U) || (BspOcpComp_Active(ctx) != 0U))
+    {
+        return 0U;
+    }
+    ctx->tim->SR = (uint32_t)~(TIM_SR_BIF | TIM_SR_B2IF);
+    return (BspOcpComp_PollTrip(ctx) == 0U) ? 1U : 0U;
+}
@@ -0,0 +1,61 @@
+#ifndef BSP_OCP_COMP_H
+#define BSP_OCP_COMP_H
+
+#include "main.h"
+
+#include <stdint.h>
+
+/*
+ * 硬件过流保护：片上 COMP（同相端接电流采样运放输出，反相端接内部 DAC 门限）-> TIM1 BRK2。
+ * 比较器翻转后经 BRK2 数字滤波直接清 MOE，输出进 OSSI 空闲电平，不经过软件，延迟 < 1us。
+ * 寄存器直驱（工程里没有 HAL COMP/DAC 驱动）：Init 配好 DAC/COMP/BRK2，之后只写 DHR（门限）和 TIM1->AF2（使能源）。
+ * 故障锁存在 TIM1 SR 的 BIF/B2IF 里，中断里轮询；清除前先确认比较器输出已回落（Rearm）。
+ */
+#ifndef BSP_OCP_COMP_MAX_CH
+#define BSP_OCP_COMP_MAX_CH (4U)
+#endif
+
+/* 比较器迟滞（COMP_CSR_HYST 编码，2 = 20mV） */
+#ifndef BSP_OCP_COMP_HYST
+#define BSP_OCP_COMP_HYST (2U)
+#endif
+
+/* PollTrip 返回的故障源 */
+#define BSP_OCP_COMP_TRIP_BRK2 (0x01U) /* 片上比较器 */
+#define BSP_OCP_COMP_TRIP_BRK (0x02U)  /* 外部 BKIN 引脚（功率板过流比较器） */
+
+typedef struct
+{
+    COMP_TypeDef *comp;
+    uint32_t inpsel;  /* CSR.INPSEL：0/1，同相端引脚 */
+    uint32_t inmsel;  /* CSR.INMSEL：选到 dac/dac_ch 对应的编码 */
+    DAC_TypeDef *dac; /* DAC1 / DAC3 */
+    uint8_t dac_ch;   /* 1 / 2 */
+    uint32_t af2_en;  /* TIM1->AF2 中的 BK2CMPxE */
+    uint8_t invert;   /* 1：输入低于门限为故障（比较器输出取反） */
+} BspOcpCompChannel;
+
+typedef struct
+{
+    TIM_TypeDef *tim;
+    const BspOcpCompChannel *ch;
+    uint8_t n_ch;
+    uint8_t ready;
+    uint8_t armed;
+    uint16_t dac_code[BSP_OCP_COMP_MAX_CH];
+} BspOcpComp;
+
+/* brk2_filter：TIMx_BDTR.BK2F（0..15）。必须在输出使能（MOE=1）之前调用 */
+void BspOcpComp_Init(BspOcpComp *ctx, TIM_TypeDef *tim, const BspOcpCompChannel *ch, uint8_t n_ch,
+                     uint32_t brk2_filter);
+void BspOcpComp_SetThreshold(BspOcpComp *ctx, uint8_t idx, uint16_t dac_code);
+uint8_t BspOcpComp_Arm(BspOcpComp *ctx);
+void BspOcpComp_Disarm(BspOcpComp *ctx);
+/* 任一比较器当前输出为故障电平时返回 1 */
+uint8_t BspOcpComp_Active(const BspOcpComp *ctx);
+/* 中断里调用：返回 BSP_OCP_COMP_TRIP_* 位（标志保持到 Rearm） */
+uint8_t BspOcpComp_PollTrip(const BspOcpComp *ctx);
+/* 输出已关闭时调用：比较器都已回落才清 BIF/B2IF 并返回 1，否则保持锁存返回 0 */
+uint8_t BspOcpComp_Rearm(BspOcpComp *ctx);
+
+#endif /* BSP_OCP_COMP_H */
@@ -22,7 +22,48 @@ void BspTim1Pwm_Init(BspTim1Pwm *ctx, TIM_HandleTypeDef *htim)
 
     ctx->htim = htim;
     ctx->period = (htim != 0) ? (uint32_t)htim->Init.Period : 0U;
+    ctx->period_f = (float)ctx->period;
     ctx->outputs_enabled = 0U;
+
+    /* CCR1-3 预装载：写入的比较值只在更新事件时整体搬到影子寄存器（HAL PWM 配置已置位，这里显式保证） */
+    if ((htim != 0) && (htim->Instance != 0))
+    {
+        htim->Instance->CCMR1 |= (TIM_CCMR1_OC1PE | TIM_CCMR1_OC2PE);
+        htim->Instance->CCMR2 |= TIM_CCMR2_OC3PE;
+    }
+}
+
+/*
+ * 把 CH4 让给编码器：ADC 注入触发改由 OC6REF 上升沿产生（TRGO2 = OC6REF，CCR6 = adc_ccr，PWM2），
+ * CH4 比较事件（CCR4 = enc_ccr）只用作 DMA 请求，由 BspMt6835Dma 在每次预装时开关 CC4DE。
+ * 中心对齐模式 1 -> 2：PWM 波形不变，比较标志/DMA 请求改为只在上计数时产生，即每周期一次、在 ADC 触发之前。
+ * 必须在 StartTrigger（CEN=1）之前调用。
+ */
+HAL_StatusTypeDef BspTim1Pwm_ConfigEncoderTrigger(BspTim1Pwm *ctx, uint32_t adc_ccr, uint32_t enc_ccr)
+{
+    if ((ctx == 0) || (ctx->htim == 0) || (ctx->htim->Instance == 0))
+    {
+        return HAL_ERROR;
+    }
+    if ((adc_ccr > ctx->period) || (enc_ccr >= adc_ccr))
+    {
+        return HAL_ERROR;
+    }
+
+    TIM_TypeDef *tim = ctx->htim->Instance;
+    if ((tim->CR1 & TIM_CR1_CEN) != 0U)
+    {
+        return HAL_ERROR;
+    }
+
+    tim->CCR6 = adc_ccr;
+    tim->CCMR3 = (tim->CCMR3 & ~(TIM_CCMR3_OC6M | TIM_CCMR3_OC6PE)) | (TIM_CCMR3_OC6M_2 | TIM_CCMR3_OC6M_1 | TIM_CCMR3_OC6M_0);
+    tim->CCER |= TIM_CCER_CC6E;
+    tim->CR2 = (tim->CR2 & ~TIM_CR2_MMS2) | (TIM_CR2_MMS2_3 | TIM_CR2_MMS2_0);
+
+    tim->CCR4 = enc_ccr;
+    tim->CR1 = (tim->CR1 & ~TIM_CR1_CMS) | TIM_CR1_CMS_1;
+    return HAL_OK;
 }
 
 HAL_StatusTypeDef BspTim1Pwm_StartTrigger(BspTim1Pwm *ctx)
@@ -117,13 +158,32 @@ void BspTim1Pwm_SetDuty(BspTim1Pwm *ctx, float duty_a, float duty_b, float duty_
     const float db = BspTim1Pwm_Clamp01(duty_b);
     const float dc = BspTim1Pwm_Clamp01(duty_c);
 
-    const uint32_t ccr1 = (uint32_t)(da * (float)ctx->period);
-    const uint32_t ccr2 = (uint32_t)(db * (float)ctx->period);
-    const uint32_t ccr3 = (uint32_t)(dc * (float)ctx->period);
+    /* 四舍五入，与控制路径（MotorApp_OutputVdqSc）的换算一致；da <= 1 时结果不超过 period */
+    const uint32_t ccr1 = (uint32_t)((da * ctx->period_f) + 0.5f);
+    const uint32_t ccr2 = (uint32_t)((db * ctx->period_f) + 0.5f);
+    const uint32_t ccr3 = (uint32_t)((dc * ctx->period_f) + 0.5f);
+
+    BspTim1Pwm_SetCompare(ctx, ccr1, ccr2, ccr3);
+}
+
+/*
+ * 整数快速路径：直接写 CCR1-3（调用方保证 ccr <= period）。
+ * 预装载 + UDIS 包裹：三次写入期间屏蔽更新事件，三相总是在同一个 PWM 周期一起生效；
+ * 若更新事件恰好落在包裹内，本周期沿用旧值，下一个更新事件再整体生效，不会出现“两相新一相旧”。
+ */
+void BspTim1Pwm_SetCompare(BspTim1Pwm *ctx, uint32_t ccr1, uint32_t ccr2, uint32_t ccr3)
+{
+    if ((ctx == 0) || (ctx->htim == 0))
+    {
+        return;
+    }
 
-    __HAL_TIM_SET_COMPARE(ctx->htim, TIM_CHANNEL_1, ccr1);
-    __HAL_TIM_SET_COMPARE(ctx->htim, TIM_CHANNEL_2, ccr2);
-    __HAL_TIM_SET_COMPARE(ctx->htim, TIM_CHANNEL_3, ccr3);
+    TIM_TypeDef *const tim = ctx->htim->Instance;
+    tim->CR1 |= TIM_CR1_UDIS;
+    tim->CCR1 = ccr1;
+    tim->CCR2 = ccr2;
+    tim->CCR3 = ccr3;
+    tim->CR1 &= ~TIM_CR1_UDIS;
 }
 
 /* 50% 占空比的物理意义：零矢量，任意两相线压差为0；自举电容充电 */
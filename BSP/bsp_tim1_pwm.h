@@ -8,10 +8,12 @@ typedef struct
 {
     TIM_HandleTypeDef *htim;
     uint32_t period; // ARR-自动重装载寄存器
+    float period_f;  // period 的浮点副本，占空比 -> CCR 换算时省一次 int->float
     uint8_t outputs_enabled;
 } BspTim1Pwm;
 
 void BspTim1Pwm_Init(BspTim1Pwm *ctx, TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef BspTim1Pwm_ConfigEncoderTrigger(BspTim1Pwm *ctx, uint32_t adc_ccr, uint32_t enc_ccr);
 HAL_StatusTypeDef BspTim1Pwm_StartTrigger(BspTim1Pwm *ctx);
 
 HAL_StatusTypeDef BspTim1Pwm_ArmIdleOutputs(BspTim1Pwm *ctx);
@@ -19,6 +21,7 @@ HAL_StatusTypeDef BspTim1Pwm_EnableOutputs(BspTim1Pwm *ctx);
 HAL_StatusTypeDef BspTim1Pwm_DisableOutputs(BspTim1Pwm *ctx);
 
 void BspTim1Pwm_SetDuty(BspTim1Pwm *ctx, float duty_a, float duty_b, float duty_c);
+void BspTim1Pwm_SetCompare(BspTim1Pwm *ctx, uint32_t ccr1, uint32_t ccr2, uint32_t ccr3);
 void BspTim1Pwm_SetNeutral(BspTim1Pwm *ctx);
 
 #endif /* BSP_TIM1_PWM_H */
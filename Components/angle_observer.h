@@ -0,0 +1,123 @@
+#ifndef COMPONENTS_ANGLE_OBSERVER_H
+#define COMPONENTS_ANGLE_OBSERVER_H
+
+#include <stdint.h>
+
+/*
+ * 三阶角度跟踪观测器（角度 / 速度 / 加速度）：
+ *   e      = wrap(theta_meas - theta_hat)
+ *   theta' = omega + k1*e
+ *   omega' = alpha + b_ff*iq + k2*e
+ *   alpha' = k3*e
+ * 三个极点都放在 -bw：k1 = 3bw，k2 = 3bw^2，k3 = bw^3。
+ * 与二阶 PI-PLL 相比，速度输出是积分状态（不直接含 Kp*e），同带宽下噪声更小；
+ * 匀加速时稳态误差为 0，alpha 同时吸收了负载扰动。b_ff = Kt/J 时 iq 前馈给出已知部分的加速度，alpha 只剩扰动。
+ */
+typedef struct
+{
+    float bw_rad_s;
+    float k1;
+    float k2;
+    float k3;
+    float dt_s;
+    float b_ff; /* 加速度前馈系数 Kt/J（rad/s^2 per A），0=关闭 */
+
+    float theta_hat_rad; /* [0, 2pi) */
+    float omega_rad_s;
+    float alpha_rad_s2;
+    float err_rad;
+} AngleObserver3;
+
+static inline float AngleObserver3_WrapPi(float x)
+{
+    const float pi = 3.14159265359f;
+    const float two_pi = 6.28318530718f;
+    while (x > pi)
+    {
+        x -= two_pi;
+    }
+    while (x < -pi)
+    {
+        x += two_pi;
+    }
+    return x;
+}
+
+static inline float AngleObserver3_Wrap2Pi(float x)
+{
+    const float two_pi = 6.28318530718f;
+    while (x >= two_pi)
+    {
+        x -= two_pi;
+    }
+    while (x < 0.0f)
+    {
+        x += two_pi;
+    }
+    return x;
+}
+
+static inline void AngleObserver3_SetBandwidth(AngleObserver3 *ctx, float bw_rad_s)
+{
+    if ((ctx == 0) || (bw_rad_s <= 0.0f))
+    {
+        return;
+    }
+    ctx->bw_rad_s = bw_rad_s;
+    ctx->k1 = 3.0f * bw_rad_s;
+    ctx->k2 = 3.0f * bw_rad_s * bw_rad_s;
+    ctx->k3 = bw_rad_s * bw_rad_s * bw_rad_s;
+}
+
+static inline void AngleObserver3_Reset(AngleObserver3 *ctx, float theta_rad)
+{
+    if (ctx == 0)
+    {
+        return;
+    }
+    ctx->theta_hat_rad = AngleObserver3_Wrap2Pi(theta_rad);
+    ctx->omega_rad_s = 0.0f;
+    ctx->alpha_rad_s2 = 0.0f;
+    ctx->err_rad = 0.0f;
+}
+
+static inline void AngleObserver3_Init(AngleObserver3 *ctx, float bw_rad_s, float dt_s, float b_ff)
+{
+    if ((ctx == 0) || (dt_s <= 0.0f))
+    {
+        return;
+    }
+    ctx->dt_s = dt_s;
+    ctx->b_ff = b_ff;
+    AngleObserver3_SetBandwidth(ctx, bw_rad_s);
+    AngleObserver3_Reset(ctx, 0.0f);
+}
+
+/* 有新角度：校正 + 前向一步 */
+static inline void AngleObserver3_Update(AngleObserver3 *ctx, float theta_meas_rad, float iq_a)
+{
+    if (ctx == 0)
+    {
+        return;
+    }
+    const float e = AngleObserver3_WrapPi(theta_meas_rad - ctx->theta_hat_rad);
+    const float dt = ctx->dt_s;
+    ctx->err_rad = e;
+    ctx->theta_hat_rad = AngleObserver3_Wrap2Pi(ctx->theta_hat_rad + (dt * (ctx->omega_rad_s + (ctx->k1 * e))));
+    ctx->omega_rad_s += dt * (ctx->alpha_rad_s2 + (ctx->b_ff * iq_a) + (ctx->k2 * e));
+    ctx->alpha_rad_s2 += dt * (ctx->k3 * e);
+}
+
+/* 本拍没有可信角度：只按模型前推（角度外推用） */
+static inline void AngleObserver3_Predict(AngleObserver3 *ctx, float iq_a)
+{
+    if (ctx == 0)
+    {
+        return;
+    }
+    const float dt = ctx->dt_s;
+    ctx->theta_hat_rad = AngleObserver3_Wrap2Pi(ctx->theta_hat_rad + (dt * ctx->omega_rad_s));
+    ctx->omega_rad_s += dt * (ctx->alpha_rad_s2 + (ctx->b_ff * iq_a));
+}
+
+#endif /* COMPONENTS_ANGLE_OBSERVER_H */
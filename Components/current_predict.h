@@ -0,0 +1,102 @@
+#ifndef COMPONENTS_CURRENT_PREDICT_H
+#define COMPONENTS_CURRENT_PREDICT_H
+
+#include <stdint.h>
+
+/*
+ * dq 电流一步预测（三电阻采样窗口不足时的替代值）：
+ *   L*did/dt = ud - R*id + we*L*iq
+ *   L*diq/dt = uq - R*iq - we*L*id - e_q
+ * 每个控制 tick 结束时 Commit 本拍 dq 电流与下发电压，下一拍采样无效时 Predict 前向欧拉推一步。
+ * 上一拍的状态只用一次：Predict / MarkMeasured 都会消耗它，没有 Commit 的 tick 之后不会再预测。
+ */
+typedef struct
+{
+    float rs_ohm;
+    float ls_h;
+    float dt_s;
+
+    float id_a;
+    float iq_a;
+    float ud_v;
+    float uq_v;
+    uint8_t valid;
+    uint16_t run_ticks; /* 连续预测次数 */
+} CurrentPredictDq;
+
+static inline void CurrentPredictDq_Reset(CurrentPredictDq *ctx)
+{
+    if (ctx == 0)
+    {
+        return;
+    }
+    ctx->id_a = 0.0f;
+    ctx->iq_a = 0.0f;
+    ctx->ud_v = 0.0f;
+    ctx->uq_v = 0.0f;
+    ctx->valid = 0U;
+    ctx->run_ticks = 0U;
+}
+
+static inline void CurrentPredictDq_Init(CurrentPredictDq *ctx, float rs_ohm, float ls_h, float dt_s)
+{
+    if ((ctx == 0) || (rs_ohm < 0.0f) || (ls_h <= 0.0f) || (dt_s <= 0.0f))
+    {
+        return;
+    }
+    ctx->rs_ohm = rs_ohm;
+    ctx->ls_h = ls_h;
+    ctx->dt_s = dt_s;
+    CurrentPredictDq_Reset(ctx);
+}
+
+/* 记录本拍 dq 电流（实测或预测）和本拍算出的 dq 电压，供下一拍预测 */
+static inline void CurrentPredictDq_Commit(CurrentPredictDq *ctx, float id_a, float iq_a, float ud_v, float uq_v)
+{
+    if (ctx == 0)
+    {
+        return;
+    }
+    ctx->id_a = id_a;
+    ctx->iq_a = iq_a;
+    ctx->ud_v = ud_v;
+    ctx->uq_v = uq_v;
+    ctx->valid = 1U;
+}
+
+/* 本拍采样有效：清零连续预测计数 */
+static inline void CurrentPredictDq_MarkMeasured(CurrentPredictDq *ctx)
+{
+    if (ctx == 0)
+    {
+        return;
+    }
+    ctx->valid = 0U;
+    ctx->run_ticks = 0U;
+}
+
+/* 前向一步预测；返回 0 表示没有可用的上一拍状态 */
+static inline uint8_t CurrentPredictDq_Predict(CurrentPredictDq *ctx, float omega_e_rad_s, float eq_v, float *id_a,
+                                               float *iq_a)
+{
+    if ((ctx == 0) || (id_a == 0) || (iq_a == 0) || (ctx->valid == 0U) || (ctx->ls_h <= 0.0f))
+    {
+        return 0U;
+    }
+
+    const float k = ctx->dt_s / ctx->ls_h;
+    const float wl = omega_e_rad_s * ctx->ls_h;
+    const float did = k * (ctx->ud_v - (ctx->rs_ohm * ctx->id_a) + (wl * ctx->iq_a));
+    const float diq = k * (ctx->uq_v - (ctx->rs_ohm * ctx->iq_a) - (wl * ctx->id_a) - eq_v);
+
+    *id_a = ctx->id_a + did;
+    *iq_a = ctx->iq_a + diq;
+    ctx->valid = 0U;
+    if (ctx->run_ticks < 0xFFFFU)
+    {
+        ctx->run_ticks++;
+    }
+    return 1U;
+}
+
+#endif /* COMPONENTS_CURRENT_PREDICT_H */
@@ -117,6 +117,7 @@ typedef struct
     uint8_t valid_mask;
     uint8_t valid_count;
     uint8_t pair_valid;
+    uint16_t pair_window_ticks; /* 选中组合两相中较短的下桥臂窗口 */
 } CurrentSense3ShuntDecision;
 
 static inline float CurrentSense_Clamp01(float x)
@@ -205,10 +206,10 @@ static inline uint8_t CurrentSense_PhaseMask(CurrentSensePhase phase)
     return (uint8_t)(1U << (uint32_t)phase);
 }
 
-/* 利用最新的占空比，推算下一轮ADC采样通道组合，丢入 CurrentSense3ShuntDecision *out 缓冲区 */
-static inline void CurrentSense3Shunt_SelectPair(float duty_a, float duty_b, float duty_c, uint32_t pwm_period_ticks,
-                                                 uint16_t min_window_ticks, CurrentSensePair preferred_pair,
-                                                 CurrentSense3ShuntDecision *out)
+/* 按三相下桥臂窗口选出下一轮ADC采样通道组合，丢入 CurrentSense3ShuntDecision *out 缓冲区 */
+static inline void CurrentSense3Shunt_SelectPairWindows(const uint16_t windows[CURRENT_SENSE_PHASE_COUNT],
+                                                        uint16_t min_window_ticks, CurrentSensePair preferred_pair,
+                                                        CurrentSense3ShuntDecision *out)
 {
     /* 遍历测试的优先级顺序（先测AB，再测AC，最后测BC） */
     /* pair_order[3] = {0, 1, 2}; */
@@ -218,19 +219,11 @@ static inline void CurrentSense3Shunt_SelectPair(float duty_a, float duty_b, flo
         CURRENT_SENSE_PAIR_BC,
     };
 
-    if (out == 0)
+    if ((out == 0) || (windows == 0))
     {
         return;
     }
 
-    /* 计算三相下桥臂导通时间(三相ADC采样窗口) */
-    /* windows[3] = {... } */
-    const uint16_t windows[CURRENT_SENSE_PHASE_COUNT] = {
-        CurrentSense_LowWindowTicks(duty_a, pwm_period_ticks),
-        CurrentSense_LowWindowTicks(duty_b, pwm_period_ticks),
-        CurrentSense_LowWindowTicks(duty_c, pwm_period_ticks),
-    };
-
     /* 用掩码 valid_mask 标记采样窗口大于 min_window_ticks 的相 */
     uint8_t valid_mask = 0U;
     if (windows[CURRENT_SENSE_PHASE_A] >= min_window_ticks)
@@ -312,6 +305,77 @@ static inline void CurrentSense3Shunt_SelectPair(float duty_a, float duty_b, flo
     out->valid_mask = valid_mask;
     out->valid_count = valid_count;
     out->pair_valid = best_pair_valid;
+    out->pair_window_ticks = best_primary;
+}
+
+/* 利用最新的占空比，推算下一轮ADC采样通道组合 */
+static inline void CurrentSense3Shunt_SelectPair(float duty_a, float duty_b, float duty_c, uint32_t pwm_period_ticks,
+                                                 uint16_t min_window_ticks, CurrentSensePair preferred_pair,
+                                                 CurrentSense3ShuntDecision *out)
+{
+    /* 计算三相下桥臂导通时间(三相ADC采样窗口) */
+    /* windows[3] = {... } */
+    const uint16_t windows[CURRENT_SENSE_PHASE_COUNT] = {
+        CurrentSense_LowWindowTicks(duty_a, pwm_period_ticks),
+        CurrentSense_LowWindowTicks(duty_b, pwm_period_ticks),
+        CurrentSense_LowWindowTicks(duty_c, pwm_period_ticks),
+    };
+
+    CurrentSense3Shunt_SelectPairWindows(windows, min_window_ticks, preferred_pair, out);
+}
+
+/*
+ * DPWM / 过调制下的选相：调制器明确告诉哪一相钳在 0（整周期下桥臂导通）或钳在 1（没有下桥臂窗口），
+ * 直接把窗口置为整周期 / 0，不依赖占空比浮点舍入；钳低的相必然进入选中的组合，另一相取窗口较长者。
+ * clamp_low_mask / clamp_high_mask 按 CURRENT_SENSE_PHASE_MASK_* 编码。
+ */
+static inline void CurrentSense3Shunt_SelectPairClamped(float duty_a, float duty_b, float duty_c, uint32_t pwm_period_ticks,
+                                                        uint16_t min_window_ticks, uint8_t clamp_low_mask,
+                                                        uint8_t clamp_high_mask, CurrentSensePair preferred_pair,
+                                                        CurrentSense3ShuntDecision *out)
+{
+    const float duty[CURRENT_SENSE_PHASE_COUNT] = {duty_a, duty_b, duty_c};
+    uint16_t windows[CURRENT_SENSE_PHASE_COUNT] = {0U, 0U, 0U};
+
+    for (uint32_t i = 0U; i < (uint32_t)CURRENT_SENSE_PHASE_COUNT; ++i)
+    {
+        const uint8_t mask = CurrentSense_PhaseMask((CurrentSensePhase)i);
+        if ((clamp_low_mask & mask) != 0U)
+        {
+            windows[i] = (uint16_t)pwm_period_ticks;
+        }
+        else if ((clamp_high_mask & mask) != 0U)
+        {
+            windows[i] = 0U;
+        }
+        else
+        {
+            windows[i] = CurrentSense_LowWindowTicks(duty[i], pwm_period_ticks);
+        }
+    }
+
+    CurrentSense3Shunt_SelectPairWindows(windows, min_window_ticks, preferred_pair, out);
+}
+
+/*
+ * 按下桥臂窗口长度决定本周期同一通道可重复转换几次（1/2/4）。
+ * window 为中心对齐下计数器顶点之后的下桥臂剩余时间（即 LowWindowTicks），注入触发在顶点附近，
+ * 额外的 n-1 次转换全部排在第一次之后，所以要求 window >= min_window + (n-1)*ticks_per_sample。
+ */
+static inline uint8_t CurrentSense_WindowSampleCount(uint16_t window_ticks, uint16_t min_window_ticks,
+                                                     uint16_t ticks_per_sample, uint8_t max_count)
+{
+    uint8_t n = 1U;
+    while (((uint32_t)n * 2U) <= (uint32_t)max_count)
+    {
+        const uint32_t need = (uint32_t)min_window_ticks + (2U * (uint32_t)n - 1U) * (uint32_t)ticks_per_sample;
+        if ((uint32_t)window_ticks < need)
+        {
+            break;
+        }
+        n = (uint8_t)(n * 2U);
+    }
+    return n;
 }
 
 static inline float CurrentSense_RawToSignedCurrentA(uint16_t raw, uint16_t offset_raw, float adc_max_counts, float vref_v,
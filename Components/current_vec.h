@@ -0,0 +1,200 @@
+#ifndef COMPONENTS_CURRENT_VEC_H
+#define COMPONENTS_CURRENT_VEC_H
+
+#include "cmsis_compiler.h"
+
+#include <math.h>
+#include <stdint.h>
+
+/*
+ * 电流矢量管理：转矩需求（折算成表贴电机的等效 Iq，= T / Kt）-> (Id, Iq)，再按电流圆限幅。
+ * 1) MTPA：T = 1.5*p*(psi*iq + (Ld - Lq)*id*iq)。对每个等效 Iq 档位，在主循环里二分求最小 |i| 的 (id, iq)：
+ *      给定 |i|，MTPA 点 id = (psi - sqrt(psi^2 + 8*dL^2*is^2)) / (4*dL)，dL = Lq - Ld；再对 |i| 二分使转矩匹配。
+ *    表贴电机（Ld = Lq）直接 id = 0、iq = 需求，表退化为直线。
+ *    表（连同档位间隔）做成两份，主循环写不用的那份、__DMB() 后再切换 active，中断只读 active，查表线性插值 O(1)。
+ * 2) 电流圆（半径 i_lim，运行中可由热降额改小，不超过表范围 i_max）：弱磁 Id 叠加在 MTPA Id 上；
+ *    D 优先（默认）：Id 先满足（|Id| <= I_max），Iq 限在 sqrt(I_max^2 - Id^2)；
+ *    Q 优先：Iq 先满足，弱磁 Id 只用剩下的部分（电压可能饱和，换转矩）。
+ */
+#define CURRENT_VEC_TBL_N (33U)
+
+typedef enum
+{
+    CURRENT_VEC_PRIO_D = 0,
+    CURRENT_VEC_PRIO_Q,
+} CurrentVecPrio;
+
+typedef struct
+{
+    float i_max_a; /* 表范围 */
+    float i_lim_a; /* 电流圆半径（<= i_max） */
+    float step_a[2]; /* 档位间隔（等效 Iq），随表一起切换 */
+    float inv_step[2];
+    float id_tbl[2][CURRENT_VEC_TBL_N];
+    float iq_tbl[2][CURRENT_VEC_TBL_N];
+    volatile uint8_t active;
+    CurrentVecPrio prio;
+
+    /* 最近一次输出（调试） */
+    float id_mtpa_a;
+    float id_a;
+    float iq_a;
+} CurrentVec;
+
+/* 给定 |i| 的 MTPA 点（dL = Lq - Ld，|dL| 很小时 id = 0） */
+static inline void CurrentVec_MtpaPoint(float psi, float dl, float is, float *id, float *iq)
+{
+    float d = 0.0f;
+    if (fabsf(dl) > 1.0e-9f)
+    {
+        d = (psi - sqrtf((psi * psi) + (8.0f * dl * dl * is * is))) / (4.0f * dl);
+        d = (d > is) ? is : ((d < -is) ? -is : d);
+    }
+    *id = d;
+    *iq = sqrtf((is * is) - (d * d));
+}
+
+/* 主循环里重建（参数变化后调用）：psi = Ke / 极对数（V*s/rad 电），iq_eq 范围 [0, i_max]；psi 非正或非有限值时不动表 */
+static inline void CurrentVec_Build(CurrentVec *ctx, float i_max_a, float psi, float ld_h, float lq_h)
+{
+    if ((ctx == 0) || (i_max_a <= 0.0f) || (psi <= 0.0f) || (isfinite(psi) == 0))
+    {
+        return;
+    }
+    const uint8_t wr = (uint8_t)(ctx->active ^ 1U);
+    const float dl = lq_h - ld_h;
+    const float step = i_max_a / (float)(CURRENT_VEC_TBL_N - 1U);
+    for (uint32_t k = 0U; k < CURRENT_VEC_TBL_N; ++k)
+    {
+        const float iq_eq = step * (float)k;
+        float id = 0.0f;
+        float iq = iq_eq;
+        if (fabsf(dl) > 1.0e-9f)
+        {
+            /* 等效 Iq = iq * (1 - dL*id/psi)，对 |i| 单调；上界取 2*iq_eq（id 不会超过 psi/dL 这一量级） */
+            float lo = 0.0f;
+            float hi = 2.0f * iq_eq;
+            for (uint8_t it = 0U; it < 24U; ++it)
+            {
+                const float mid = 0.5f * (lo + hi);
+                CurrentVec_MtpaPoint(psi, dl, mid, &id, &iq);
+                const float t_eq = iq * (1.0f - ((dl * id) / psi));
+                if (t_eq < iq_eq)
+                {
+                    lo = mid;
+                }
+                else
+                {
+                    hi = mid;
+                }
+            }
+            CurrentVec_MtpaPoint(psi, dl, 0.5f * (lo + hi), &id, &iq);
+        }
+        ctx->id_tbl[wr][k] = id;
+        ctx->iq_tbl[wr][k] = iq;
+    }
+    ctx->i_max_a = i_max_a;
+    if ((ctx->i_lim_a <= 0.0f) || (ctx->i_lim_a > i_max_a))
+    {
+        ctx->i_lim_a = i_max_a;
+    }
+    ctx->step_a[wr] = step;
+    ctx->inv_step[wr] = 1.0f / step;
+    __DMB();
+    ctx->active = wr;
+}
+
+static inline void CurrentVec_Init(CurrentVec *ctx, float i_max_a, float psi, float ld_h, float lq_h)
+{
+    if (ctx == 0)
+    {
+        return;
+    }
+    ctx->active = 0U;
+    ctx->i_lim_a = 0.0f;
+    ctx->prio = CURRENT_VEC_PRIO_D;
+    ctx->id_mtpa_a = 0.0f;
+    ctx->id_a = 0.0f;
+    ctx->iq_a = 0.0f;
+    CurrentVec_Build(ctx, i_max_a, psi, ld_h, lq_h);
+}
+
+/* 电流圆半径（中断里随时可调，限制在表范围内） */
+static inline void CurrentVec_SetLimit(CurrentVec *ctx, float i_lim_a)
+{
+    if (ctx == 0)
+    {
+        return;
+    }
+    ctx->i_lim_a = (i_lim_a > ctx->i_max_a) ? ctx->i_max_a : ((i_lim_a < 0.0f) ? 0.0f : i_lim_a);
+}
+
+/* 查表：等效 Iq（带符号）-> MTPA (id, iq)，超出表范围按端点 */
+static inline void CurrentVec_Mtpa(const CurrentVec *ctx, float iq_eq_a, float *id_a, float *iq_a)
+{
+    const uint8_t a = ctx->active;
+    const float x = fabsf(iq_eq_a) * ctx->inv_step[a];
+    uint32_t k = (uint32_t)x;
+    float f = x - (float)k;
+    if (k >= (CURRENT_VEC_TBL_N - 1U))
+    {
+        k = CURRENT_VEC_TBL_N - 2U;
+        f = 1.0f;
+    }
+    const float id = ctx->id_tbl[a][k] + (f * (ctx->id_tbl[a][k + 1U] - ctx->id_tbl[a][k]));
+    const float iq = ctx->iq_tbl[a][k] + (f * (ctx->iq_tbl[a][k + 1U] - ctx->iq_tbl[a][k]));
+    *id_a = id;
+    *iq_a = (iq_eq_a < 0.0f) ? -iq : iq;
+}
+
+/*
+ * 每个电流环节拍调用一次：iq_eq 为转矩需求（等效 Iq），id_fw 为弱磁 Id（<= 0），
+ * id_extra 为额外的 Id 给定（id_ref）。输出限在半径 i_lim 的圆内，返回 Iq 还能用的幅值（给速度环限幅/反算积分用）。
+ */
+static inline float CurrentVec_Apply(CurrentVec *ctx, float iq_eq_a, float id_fw_a, float id_extra_a, float *id_a,
+                                     float *iq_a)
+{
+    if ((ctx == 0) || (ctx->i_max_a <= 0.0f))
+    {
+        *id_a = id_extra_a;
+        *iq_a = iq_eq_a;
+        return 0.0f;
+    }
+    const float i_max = ctx->i_lim_a;
+    float id_m = 0.0f;
+    float iq = 0.0f;
+    CurrentVec_Mtpa(ctx, iq_eq_a, &id_m, &iq);
+    ctx->id_mtpa_a = id_m;
+
+    float id = id_m + id_fw_a + id_extra_a;
+    float iq_room = 0.0f;
+    if (ctx->prio == CURRENT_VEC_PRIO_Q)
+    {
+        if (iq > i_max)
+        {
+            iq = i_max;
+        }
+        else if (iq < -i_max)
+        {
+            iq = -i_max;
+        }
+        const float r2 = (i_max * i_max) - (iq * iq);
+        const float id_room = (r2 > 0.0f) ? sqrtf(r2) : 0.0f;
+        id = (id > id_room) ? id_room : ((id < -id_room) ? -id_room : id);
+        iq_room = i_max;
+    }
+    else
+    {
+        id = (id > i_max) ? i_max : ((id < -i_max) ? -i_max : id);
+        const float r2 = (i_max * i_max) - (id * id);
+        iq_room = (r2 > 0.0f) ? sqrtf(r2) : 0.0f;
+        iq = (iq > iq_room) ? iq_room : ((iq < -iq_room) ? -iq_room : iq);
+    }
+    ctx->id_a = id;
+    ctx->iq_a = iq;
+    *id_a = id;
+    *iq_a = iq;
+    return iq_room;
+}
+
+#endif /* COMPONENTS_CURRENT_VEC_H */
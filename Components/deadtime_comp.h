@@ -0,0 +1,237 @@
+#ifndef COMPONENTS_DEADTIME_COMP_H
+#define COMPONENTS_DEADTIME_COMP_H
+
+#include <math.h>
+#include <stdint.h>
+
+/*
+ * 死区 / 管压降补偿：按相电流方向给每相占空比加 ±duty_comp。
+ * 电流流出逆变器（i>0）时死区内下管续流，相电压偏低，所以 duty 加；反之减。
+ * 过零附近用 i/i_band 线性过渡，避免电流噪声让补偿来回跳。
+ */
+typedef struct
+{
+    float duty_comp; /* 补偿幅值（占空比，0=关闭），约等于 (Td + 开关延时) / Ts */
+    float i_band_a;  /* 过零平滑带宽 */
+} DeadTimeComp;
+
+static inline void DeadTimeComp_Init(DeadTimeComp *ctx, float duty_comp, float i_band_a)
+{
+    if (ctx == 0)
+    {
+        return;
+    }
+    ctx->duty_comp = (duty_comp > 0.0f) ? duty_comp : 0.0f;
+    ctx->i_band_a = (i_band_a > 0.0f) ? i_band_a : 0.0f;
+}
+
+/* 平滑符号函数：|i| >= band 时为 ±1 */
+static inline float DeadTimeComp_SoftSign(float i_a, float band_a)
+{
+    if (band_a <= 0.0f)
+    {
+        return (i_a > 0.0f) ? 1.0f : ((i_a < 0.0f) ? -1.0f : 0.0f);
+    }
+    const float x = i_a / band_a;
+    if (x > 1.0f)
+    {
+        return 1.0f;
+    }
+    if (x < -1.0f)
+    {
+        return -1.0f;
+    }
+    return x;
+}
+
+static inline float DeadTimeComp_Clamp01(float x)
+{
+    if (x < 0.0f)
+    {
+        return 0.0f;
+    }
+    if (x > 1.0f)
+    {
+        return 1.0f;
+    }
+    return x;
+}
+
+/* 对三相占空比叠加补偿；skip_mask（bit0..2 = A/B/C）中的相不开关（DPWM/过调制钳位），不补偿 */
+static inline void DeadTimeComp_Apply(const DeadTimeComp *ctx, float ia_a, float ib_a, float ic_a, uint8_t skip_mask,
+                                      float *duty_a, float *duty_b, float *duty_c)
+{
+    if ((ctx == 0) || (duty_a == 0) || (duty_b == 0) || (duty_c == 0) || (ctx->duty_comp <= 0.0f))
+    {
+        return;
+    }
+
+    if ((skip_mask & 0x01U) == 0U)
+    {
+        *duty_a = DeadTimeComp_Clamp01(*duty_a + (ctx->duty_comp * DeadTimeComp_SoftSign(ia_a, ctx->i_band_a)));
+    }
+    if ((skip_mask & 0x02U) == 0U)
+    {
+        *duty_b = DeadTimeComp_Clamp01(*duty_b + (ctx->duty_comp * DeadTimeComp_SoftSign(ib_a, ctx->i_band_a)));
+    }
+    if ((skip_mask & 0x04U) == 0U)
+    {
+        *duty_c = DeadTimeComp_Clamp01(*duty_c + (ctx->duty_comp * DeadTimeComp_SoftSign(ic_a, ctx->i_band_a)));
+    }
+}
+
+/*
+ * 静止 Id 扫描辨识补偿幅值：
+ * 电流环只给 Id（转子不受转矩），按台阶从 -i_max 扫到 +i_max，每台阶先等 settle 再平均 ud。
+ * 模型 ud = R*id + Vdt*r(theta, id)，r 为三相符号向量 Clarke/Park 后的 d 轴分量（theta=0 时为 ±4/3），
+ * 对所有台阶做两参数最小二乘得到 R 和 Vdt，duty_comp = Vdt / Vbus。
+ */
+typedef enum
+{
+    DEADTIME_IDENT_IDLE = 0,
+    DEADTIME_IDENT_RUN,
+    DEADTIME_IDENT_DONE,
+    DEADTIME_IDENT_FAIL,
+} DeadTimeIdentState;
+
+typedef struct
+{
+    DeadTimeIdentState state;
+    float i_max_a;
+    uint16_t steps;        /* 台阶数（偶数，正负对称，不含 0） */
+    uint32_t settle_ticks; /* 每台阶稳定时间 */
+    uint32_t avg_ticks;    /* 每台阶平均时间 */
+
+    uint16_t step;
+    uint32_t tick;
+    float acc_id;
+    float acc_ud;
+    float acc_r;
+
+    /* 最小二乘正规方程累加量 [id r]' [id r] 与 [id r]' ud */
+    float s_ii;
+    float s_ir;
+    float s_rr;
+    float s_iu;
+    float s_ru;
+
+    float r_ohm;
+    float vdt_v;
+} DeadTimeIdent;
+
+static inline void DeadTimeIdent_Start(DeadTimeIdent *ctx, float i_max_a, uint16_t steps, uint32_t settle_ticks,
+                                       uint32_t avg_ticks)
+{
+    if ((ctx == 0) || (i_max_a <= 0.0f) || (steps < 2U) || (avg_ticks == 0U))
+    {
+        return;
+    }
+    ctx->i_max_a = i_max_a;
+    ctx->steps = (uint16_t)(steps & (uint16_t)~1U);
+    ctx->settle_ticks = settle_ticks;
+    ctx->avg_ticks = avg_ticks;
+    ctx->step = 0U;
+    ctx->tick = 0U;
+    ctx->acc_id = 0.0f;
+    ctx->acc_ud = 0.0f;
+    ctx->acc_r = 0.0f;
+    ctx->s_ii = 0.0f;
+    ctx->s_ir = 0.0f;
+    ctx->s_rr = 0.0f;
+    ctx->s_iu = 0.0f;
+    ctx->s_ru = 0.0f;
+    ctx->r_ohm = 0.0f;
+    ctx->vdt_v = 0.0f;
+    ctx->state = DEADTIME_IDENT_RUN;
+}
+
+static inline void DeadTimeIdent_Abort(DeadTimeIdent *ctx)
+{
+    if (ctx == 0)
+    {
+        return;
+    }
+    ctx->state = DEADTIME_IDENT_IDLE;
+}
+
+/* 当前台阶的 Id 给定：-i_max .. -i_max/(n/2) , +i_max/(n/2) .. +i_max */
+static inline float DeadTimeIdent_IdRef(const DeadTimeIdent *ctx)
+{
+    if ((ctx == 0) || (ctx->state != DEADTIME_IDENT_RUN) || (ctx->steps < 2U))
+    {
+        return 0.0f;
+    }
+    const int32_t half = (int32_t)(ctx->steps / 2U);
+    int32_t k = (int32_t)ctx->step - half; /* -half .. half-1 */
+    if (k >= 0)
+    {
+        k += 1; /* 跳过 0 */
+    }
+    return ctx->i_max_a * ((float)k / (float)half);
+}
+
+/* 三相符号向量在 d 轴上的投影（幅值不变 Clarke + Park） */
+static inline float DeadTimeIdent_SignProjD(float ia_a, float ib_a, float ic_a, float sin_theta_e, float cos_theta_e)
+{
+    const float sa = (ia_a >= 0.0f) ? 1.0f : -1.0f;
+    const float sb = (ib_a >= 0.0f) ? 1.0f : -1.0f;
+    const float sc = (ic_a >= 0.0f) ? 1.0f : -1.0f;
+    const float s_alpha = (2.0f / 3.0f) * (sa - (0.5f * sb) - (0.5f * sc));
+    const float s_beta = 0.57735026919f * (sb - sc);
+    return (s_alpha * cos_theta_e) + (s_beta * sin_theta_e);
+}
+
+/* 每个控制 tick 调用一次：id/ud 为电流环本拍的实测 d 轴电流与输出 d 轴电压，r 为 SignProjD */
+static inline void DeadTimeIdent_Tick(DeadTimeIdent *ctx, float id_a, float ud_v, float r)
+{
+    if ((ctx == 0) || (ctx->state != DEADTIME_IDENT_RUN))
+    {
+        return;
+    }
+
+    ctx->tick++;
+    if (ctx->tick <= ctx->settle_ticks)
+    {
+        return;
+    }
+
+    ctx->acc_id += id_a;
+    ctx->acc_ud += ud_v;
+    ctx->acc_r += r;
+    if (ctx->tick < (ctx->settle_ticks + ctx->avg_ticks))
+    {
+        return;
+    }
+
+    const float inv_n = 1.0f / (float)ctx->avg_ticks;
+    const float i = ctx->acc_id * inv_n;
+    const float u = ctx->acc_ud * inv_n;
+    const float rr = ctx->acc_r * inv_n;
+    ctx->s_ii += i * i;
+    ctx->s_ir += i * rr;
+    ctx->s_rr += rr * rr;
+    ctx->s_iu += i * u;
+    ctx->s_ru += rr * u;
+
+    ctx->tick = 0U;
+    ctx->acc_id = 0.0f;
+    ctx->acc_ud = 0.0f;
+    ctx->acc_r = 0.0f;
+    ctx->step++;
+    if (ctx->step < ctx->steps)
+    {
+        return;
+    }
+
+    const float det = (ctx->s_ii * ctx->s_rr) - (ctx->s_ir * ctx->s_ir);
+    if (fabsf(det) < 1.0e-9f)
+    {
+        ctx->state = DEADTIME_IDENT_FAIL;
+        return;
+    }
+    ctx->r_ohm = ((ctx->s_rr * ctx->s_iu) - (ctx->s_ir * ctx->s_ru)) / det;
+    ctx->vdt_v = ((ctx->s_ii * ctx->s_ru) - (ctx->s_ir * ctx->s_iu)) / det;
+    ctx->state = (ctx->vdt_v > 0.0f) ? DEADTIME_IDENT_DONE : DEADTIME_IDENT_FAIL;
+}
+
+#endif /* COMPONENTS_DEADTIME_COMP_H */
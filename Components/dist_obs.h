@@ -0,0 +1,76 @@
+#ifndef COMPONENTS_DIST_OBS_H
+#define COMPONENTS_DIST_OBS_H
+
+#include <math.h>
+#include <stdint.h>
+
+/*
+ * 负载转矩扰动观测器（降阶，名义模型 J*omega' = Kt*iq - B*omega - Td）：
+ *   Td_hat' = g * (Kt*iq - B*omega - J*omega' - Td_hat)
+ * 即把 (Kt*iq - B*omega - J*omega') 过一阶低通 g/(s+g)。离散时极点取精确值 exp(-g*dt)，omega' 用后向差分：
+ *   Td_hat += k * (Kt*iq - B*omega - J*(omega - omega_prev)/dt - Td_hat)，k = 1 - exp(-g*dt)
+ * k 在 (0, 1) 内，任意 g 都稳定（前向欧拉 k = g*dt，g*dt >= 2 时发散）；匀加速时稳态无偏。
+ * 差分只经过 k 进估计值，噪声和原来 z = Td_hat + g*J*omega 的写法相当。
+ * Td_hat 含模型误差（J/B 偏差、库仑摩擦），补偿后 PI 积分器只剩很小的残差。
+ */
+typedef struct
+{
+    float j_kgm2;
+    float b_nms;
+    float kt_nm_a;
+    float g_rad_s;
+    float dt_s;
+    float k_lp; /* 1 - exp(-g*dt) */
+
+    float omega_prev_rad_s;
+    float td_hat_nm;
+} DistObs;
+
+static inline void DistObs_Reset(DistObs *ctx, float omega_rad_s)
+{
+    if (ctx == 0)
+    {
+        return;
+    }
+    ctx->td_hat_nm = 0.0f;
+    ctx->omega_prev_rad_s = omega_rad_s;
+}
+
+static inline void DistObs_SetBandwidth(DistObs *ctx, float g_rad_s, float omega_rad_s)
+{
+    if ((ctx == 0) || (g_rad_s <= 0.0f) || (ctx->dt_s <= 0.0f))
+    {
+        return;
+    }
+    ctx->g_rad_s = g_rad_s;
+    ctx->k_lp = 1.0f - expf(-g_rad_s * ctx->dt_s);
+    DistObs_Reset(ctx, omega_rad_s);
+}
+
+static inline void DistObs_Init(DistObs *ctx, float j_kgm2, float b_nms, float kt_nm_a, float g_rad_s, float dt_s)
+{
+    if ((ctx == 0) || (j_kgm2 <= 0.0f) || (kt_nm_a <= 0.0f) || (g_rad_s <= 0.0f) || (dt_s <= 0.0f))
+    {
+        return;
+    }
+    ctx->j_kgm2 = j_kgm2;
+    ctx->b_nms = b_nms;
+    ctx->kt_nm_a = kt_nm_a;
+    ctx->dt_s = dt_s;
+    DistObs_SetBandwidth(ctx, g_rad_s, 0.0f);
+}
+
+/* iq / omega 为实测量（同一方向），返回 Td_hat（N*m） */
+static inline float DistObs_Update(DistObs *ctx, float iq_a, float omega_rad_s)
+{
+    if ((ctx == 0) || (ctx->dt_s <= 0.0f))
+    {
+        return 0.0f;
+    }
+    const float j_acc = ctx->j_kgm2 * (omega_rad_s - ctx->omega_prev_rad_s) / ctx->dt_s;
+    ctx->omega_prev_rad_s = omega_rad_s;
+    ctx->td_hat_nm += ctx->k_lp * ((ctx->kt_nm_a * iq_a) - (ctx->b_nms * omega_rad_s) - j_acc - ctx->td_hat_nm);
+    return ctx->td_hat_nm;
+}
+
+#endif /* COMPONENTS_DIST_OBS_H */
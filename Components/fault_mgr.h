@@ -0,0 +1,155 @@
+#ifndef COMPONENTS_FAULT_MGR_H
+#define COMPONENTS_FAULT_MGR_H
+
+#include <stdint.h>
+
+/*
+ * 故障管理：故障码 + 每个故障的处理策略 + 带时间戳的历史环。
+ * 策略：WARN 只记录；STOP 停机，条件消失（Release）后自动解除；LATCH 停机并锁存，需上层显式清除。
+ * Raise 只在故障由无到有时记一条历史（同一故障持续存在不刷屏），返回本次要执行的动作，停机由上层统一执行。
+ * 边沿型故障（过流、编码器）不调 Release，Clear 时一并清掉 active 位；条件型故障（Vbus、采样）由 Release 解除。
+ * 不做互斥：中断和主循环都会调用时，由上层关中断包住。
+ */
+typedef enum
+{
+    FAULT_NONE = 0,
+    FAULT_OC_SW,          /* 软件采样过流 */
+    FAULT_OC_HW,          /* 片上比较器 -> BRK2 */
+    FAULT_OC_BKIN,        /* BKIN 引脚 */
+    FAULT_ENC_CRC,        /* 编码器连续 CRC/STATUS 错 */
+    FAULT_ENC_TIMEOUT,    /* 编码器连续无帧 */
+    FAULT_VBUS_UNDER,
+    FAULT_VBUS_OVER,
+    FAULT_SAMPLE_INVALID, /* 电流采样窗口连续不足且无预测可用 */
+    FAULT_ISR_OVERRUN,    /* 控制中断超时 */
+    FAULT_COUNT,
+} FaultCode;
+
+typedef enum
+{
+    FAULT_REACT_WARN = 0,
+    FAULT_REACT_STOP,
+    FAULT_REACT_LATCH,
+} FaultReact;
+
+#define FAULT_MGR_HIST_N (16U)
+#define FAULT_MGR_BIT(code) (1UL << (uint32_t)(code))
+
+typedef struct
+{
+    uint32_t t_ms;
+    float value; /* 触发时的相关量（电流/电压/计数），含义随故障码 */
+    uint8_t code;
+} FaultRecord;
+
+typedef struct
+{
+    uint8_t react[FAULT_COUNT];
+    uint32_t halt_mask;    /* 策略不是 WARN 的故障位 */
+    uint32_t active_mask;  /* 当前存在 */
+    uint32_t latched_mask; /* 已锁存（Clear 前一直保持） */
+    uint16_t count[FAULT_COUNT];
+    FaultRecord hist[FAULT_MGR_HIST_N];
+    uint8_t hist_head; /* 下一条写入位置 */
+    uint8_t hist_n;
+} FaultMgr;
+
+/* react 为 FAULT_COUNT 项的策略表，0 时全部 WARN */
+static inline void FaultMgr_Init(FaultMgr *ctx, const uint8_t *react)
+{
+    if (ctx == 0)
+    {
+        return;
+    }
+    ctx->halt_mask = 0U;
+    ctx->active_mask = 0U;
+    ctx->latched_mask = 0U;
+    ctx->hist_head = 0U;
+    ctx->hist_n = 0U;
+    for (uint8_t i = 0U; i < (uint8_t)FAULT_COUNT; ++i)
+    {
+        const uint8_t r = (react != 0) ? react[i] : (uint8_t)FAULT_REACT_WARN;
+        ctx->react[i] = (r > (uint8_t)FAULT_REACT_LATCH) ? (uint8_t)FAULT_REACT_LATCH : r;
+        ctx->count[i] = 0U;
+        if ((i != (uint8_t)FAULT_NONE) && (ctx->react[i] != (uint8_t)FAULT_REACT_WARN))
+        {
+            ctx->halt_mask |= FAULT_MGR_BIT(i);
+        }
+    }
+}
+
+/* 上报故障，返回要执行的动作；已存在的故障再次上报返回 WARN（无新动作） */
+static inline FaultReact FaultMgr_Raise(FaultMgr *ctx, FaultCode code, uint32_t t_ms, float value)
+{
+    if ((ctx == 0) || (code == FAULT_NONE) || (code >= FAULT_COUNT))
+    {
+        return FAULT_REACT_WARN;
+    }
+    const uint32_t bit = FAULT_MGR_BIT(code);
+    if ((ctx->active_mask & bit) != 0U)
+    {
+        return FAULT_REACT_WARN;
+    }
+    ctx->active_mask |= bit;
+    if (ctx->count[code] < 0xFFFFU)
+    {
+        ctx->count[code]++;
+    }
+    FaultRecord *rec = &ctx->hist[ctx->hist_head];
+    rec->t_ms = t_ms;
+    rec->value = value;
+    rec->code = (uint8_t)code;
+    ctx->hist_head = (uint8_t)((ctx->hist_head + 1U) % FAULT_MGR_HIST_N);
+    if (ctx->hist_n < FAULT_MGR_HIST_N)
+    {
+        ctx->hist_n++;
+    }
+
+    const FaultReact r = (FaultReact)ctx->react[code];
+    if (r == FAULT_REACT_LATCH)
+    {
+        ctx->latched_mask |= bit;
+    }
+    return r;
+}
+
+/* 条件型故障消失：清 active 位（已锁存的保持锁存） */
+static inline void FaultMgr_Release(FaultMgr *ctx, FaultCode code)
+{
+    if ((ctx == 0) || (code >= FAULT_COUNT))
+    {
+        return;
+    }
+    ctx->active_mask &= ~FAULT_MGR_BIT(code);
+}
+
+/* 清除锁存（keep_mask 中的位保持，例如硬件还没回落的过流） */
+static inline void FaultMgr_Clear(FaultMgr *ctx, uint32_t keep_mask)
+{
+    if (ctx == 0)
+    {
+        return;
+    }
+    const uint32_t clr = ctx->latched_mask & ~keep_mask;
+    ctx->latched_mask &= ~clr;
+    ctx->active_mask &= ~clr;
+}
+
+/* 禁止使能输出的故障：已锁存的 + 仍存在的 STOP/LATCH 故障 */
+static inline uint32_t FaultMgr_Blocking(const FaultMgr *ctx)
+{
+    return (ctx != 0) ? ((ctx->active_mask | ctx->latched_mask) & ctx->halt_mask) : 0U;
+}
+
+/* 第 age 新的历史记录（0 为最新），没有时返回 0 */
+static inline const FaultRecord *FaultMgr_History(const FaultMgr *ctx, uint8_t age)
+{
+    if ((ctx == 0) || (age >= ctx->hist_n))
+    {
+        return 0;
+    }
+    const uint8_t idx = (uint8_t)((ctx->hist_head + FAULT_MGR_HIST_N - 1U - age) % FAULT_MGR_HIST_N);
+    return &ctx->hist[idx];
+}
+
+#endif /* COMPONENTS_FAULT_MGR_H */
@@ -0,0 +1,65 @@
+#ifndef COMPONENTS_FIELD_WEAKEN_H
+#define COMPONENTS_FIELD_WEAKEN_H
+
+#include <stdint.h>
+
+/*
+ * 电压反馈弱磁：电压矢量幅值超过 u_ratio * v_limit 时积分出负 Id，低于时积分回 0（自然退出，无切换）。
+ *   id += ki * (u_ratio * v_limit - |u|) * dt，限制在 [id_min, 0]
+ * |u| 取上一拍电流环输出（限幅后），饱和时 |u| = v_limit，误差固定为 -(1 - u_ratio) * v_limit，Id 按固定斜率下探。
+ * 电流圆限幅和 MTPA 在 current_vec.h（弱磁 Id 叠加在 MTPA Id 上）。
+ * 回路增益 d|u|/dId 约 we*Ld/Vbus，随转速上升，ki 按最高转速下的带宽选。
+ */
+typedef struct
+{
+    float ki;      /* A / (pu*s) */
+    float dt_s;
+    float u_ratio; /* 目标电压占限幅的比例，留出电流环动态余量 */
+    float id_min_a;
+
+    float id_a; /* 输出，<= 0 */
+} FieldWeaken;
+
+static inline void FieldWeaken_Reset(FieldWeaken *ctx)
+{
+    if (ctx == 0)
+    {
+        return;
+    }
+    ctx->id_a = 0.0f;
+}
+
+static inline void FieldWeaken_Init(FieldWeaken *ctx, float ki, float dt_s, float u_ratio, float id_min_a)
+{
+    if ((ctx == 0) || (ki <= 0.0f) || (dt_s <= 0.0f) || (u_ratio <= 0.0f) || (u_ratio > 1.0f) || (id_min_a > 0.0f))
+    {
+        return;
+    }
+    ctx->ki = ki;
+    ctx->dt_s = dt_s;
+    ctx->u_ratio = u_ratio;
+    ctx->id_min_a = id_min_a;
+    FieldWeaken_Reset(ctx);
+}
+
+/* 每个电流环节拍调用一次，返回弱磁 Id（A，<= 0） */
+static inline float FieldWeaken_Step(FieldWeaken *ctx, float u_mag_pu, float v_limit_pu)
+{
+    if ((ctx == 0) || (ctx->dt_s <= 0.0f))
+    {
+        return 0.0f;
+    }
+    float id = ctx->id_a + (ctx->ki * ((ctx->u_ratio * v_limit_pu) - u_mag_pu) * ctx->dt_s);
+    if (id > 0.0f)
+    {
+        id = 0.0f;
+    }
+    if (id < ctx->id_min_a)
+    {
+        id = ctx->id_min_a;
+    }
+    ctx->id_a = id;
+    return id;
+}
+
+#endif /* COMPONENTS_FIELD_WEAKEN_H */
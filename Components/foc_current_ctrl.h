@@ -66,26 +66,57 @@ static inline float FocCurrentCtrl_Clamp(float x, float lo, float hi)
     return x;
 }
 
-/* Clarke/Park 变换将采样电流投影至 dq 轴，用电流环PI调节器计算d/q 轴目标电压，输入FocCurrentCtrlOut *out缓冲区中 */
-static inline void FocCurrentCtrl_StepScFf(FocCurrentCtrl *ctx, float ia_a, float ib_a, float ic_a, float sin_theta_e,
-                                           float cos_theta_e, float id_ref_a, float iq_ref_a, float ud_ff_v, float uq_ff_v,
-                                           FocCurrentCtrlOut *out)
+/* 运行时改 PI 参数，积分器保持（积分量按电压存，改 Ki 输出不跳变），运行中在线微调用 */
+static inline void FocCurrentCtrl_UpdateGains(FocCurrentCtrl *ctx, float kp, float ki)
 {
-    (void)ic_a; /* only needed for validity checks; Clarke assumes ia+ib+ic=0 */
+    if ((ctx == 0) || (kp <= 0.0f) || (ki < 0.0f))
+    {
+        return;
+    }
+    ctx->kp = kp;
+    ctx->ki = ki;
+}
 
-    if ((ctx == 0) || (out == 0) || (ctx->dt_s <= 0.0f) || (ctx->vbus_v <= 0.0f))
+/* 运行时改 PI 参数（自整定），积分器清零 */
+static inline void FocCurrentCtrl_SetGains(FocCurrentCtrl *ctx, float kp, float ki)
+{
+    if ((ctx == 0) || (kp <= 0.0f) || (ki < 0.0f))
     {
         return;
     }
+    FocCurrentCtrl_UpdateGains(ctx, kp, ki);
+    FocCurrentCtrl_Reset(ctx);
+}
 
+/* 三相电流 -> dq（幅值不变 Clarke + Park） */
+static inline void FocCurrentCtrl_ParkSc(float ia_a, float ib_a, float sin_theta_e, float cos_theta_e, float *id_a,
+                                         float *iq_a)
+{
     /* Clarke Transform */
     const float inv_sqrt3 = 0.57735026919f; // 根号3的倒数
     const float i_alpha = ia_a;
     const float i_beta = (ia_a + 2.0f * ib_a) * inv_sqrt3;
 
     /* Park Transform  */
-    const float id_a = (i_alpha * cos_theta_e) + (i_beta * sin_theta_e);
-    const float iq_a = (-i_alpha * sin_theta_e) + (i_beta * cos_theta_e);
+    *id_a = (i_alpha * cos_theta_e) + (i_beta * sin_theta_e);
+    *iq_a = (-i_alpha * sin_theta_e) + (i_beta * cos_theta_e);
+}
+
+/* Clarke/Park 变换将采样电流投影至 dq 轴，用电流环PI调节器计算d/q 轴目标电压，输入FocCurrentCtrlOut *out缓冲区中 */
+static inline void FocCurrentCtrl_StepScFf(FocCurrentCtrl *ctx, float ia_a, float ib_a, float ic_a, float sin_theta_e,
+                                           float cos_theta_e, float id_ref_a, float iq_ref_a, float ud_ff_v, float uq_ff_v,
+                                           FocCurrentCtrlOut *out)
+{
+    (void)ic_a; /* only needed for validity checks; Clarke assumes ia+ib+ic=0 */
+
+    if ((ctx == 0) || (out == 0) || (ctx->dt_s <= 0.0f) || (ctx->vbus_v <= 0.0f))
+    {
+        return;
+    }
+
+    float id_a = 0.0f;
+    float iq_a = 0.0f;
+    FocCurrentCtrl_ParkSc(ia_a, ib_a, sin_theta_e, cos_theta_e, &id_a, &iq_a);
 
     const float ed = id_ref_a - id_a;
     const float eq = iq_ref_a - iq_a;
@@ -0,0 +1,71 @@
+#ifndef COMPONENTS_FOC_POS_CTRL_H
+#define COMPONENTS_FOC_POS_CTRL_H
+
+#include <stdint.h>
+
+/* 位置环（外环）：omega_ref = omega_ff + kp*e + ki*∫e，输出限幅，积分按饱和反算 */
+typedef struct
+{
+    float kp;                /* (rad/s) / rad */
+    float ki;                /* (rad/s) / (rad*s) */
+    float dt_s;              /* position loop period */
+    float omega_limit_rad_s; /* output clamp */
+
+    float omega_int_rad_s;
+} FocPosCtrl;
+
+static inline void FocPosCtrl_Init(FocPosCtrl *ctx, float kp, float ki, float dt_s, float omega_limit_rad_s)
+{
+    if ((ctx == 0) || (dt_s <= 0.0f) || (omega_limit_rad_s <= 0.0f))
+    {
+        return;
+    }
+
+    ctx->kp = kp;
+    ctx->ki = ki;
+    ctx->dt_s = dt_s;
+    ctx->omega_limit_rad_s = omega_limit_rad_s;
+    ctx->omega_int_rad_s = 0.0f;
+}
+
+static inline void FocPosCtrl_Reset(FocPosCtrl *ctx)
+{
+    if (ctx == 0)
+    {
+        return;
+    }
+    ctx->omega_int_rad_s = 0.0f;
+}
+
+static inline float FocPosCtrl_Clamp(float x, float lo, float hi)
+{
+    if (x < lo)
+    {
+        return lo;
+    }
+    if (x > hi)
+    {
+        return hi;
+    }
+    return x;
+}
+
+static inline float FocPosCtrl_Step(FocPosCtrl *ctx, float pos_err_rad, float omega_ff_rad_s)
+{
+    if ((ctx == 0) || (ctx->dt_s <= 0.0f) || (ctx->omega_limit_rad_s <= 0.0f))
+    {
+        return 0.0f;
+    }
+
+    const float p = ctx->kp * pos_err_rad;
+    const float i_next = ctx->omega_int_rad_s + (ctx->ki * pos_err_rad * ctx->dt_s);
+
+    const float omega_unsat = omega_ff_rad_s + p + i_next;
+    const float omega = FocPosCtrl_Clamp(omega_unsat, -ctx->omega_limit_rad_s, ctx->omega_limit_rad_s);
+
+    /* anti-windup: back-calculate i-term to match saturated output */
+    ctx->omega_int_rad_s = (ctx->ki != 0.0f) ? (omega - omega_ff_rad_s - p) : 0.0f;
+    return omega;
+}
+
+#endif /* COMPONENTS_FOC_POS_CTRL_H */
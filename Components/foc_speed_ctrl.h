@@ -27,6 +27,17 @@ static inline void FocSpeedCtrl_Init(FocSpeedCtrl *ctx, float kp, float ki, floa
     ctx->iq_int_a = 0.0f;
 }
 
+/* 运行时改 PI 参数（自整定用），积分器保持 */
+static inline void FocSpeedCtrl_SetGains(FocSpeedCtrl *ctx, float kp, float ki)
+{
+    if ((ctx == 0) || (kp < 0.0f) || (ki < 0.0f))
+    {
+        return;
+    }
+    ctx->kp = kp;
+    ctx->ki = ki;
+}
+
 /* 速度环积分器清零 */
 static inline void FocSpeedCtrl_Reset(FocSpeedCtrl *ctx)
 {
@@ -50,7 +61,8 @@ static inline float FocSpeedCtrl_Clamp(float x, float lo, float hi)
     return x;
 }
 
-static inline float FocSpeedCtrl_Step(FocSpeedCtrl *ctx, float omega_ref_rad_s, float omega_meas_rad_s)
+/* iq = Kp*e + 积分 + iq_ff；限幅后反算积分，前馈不进积分器 */
+static inline float FocSpeedCtrl_StepFf(FocSpeedCtrl *ctx, float omega_ref_rad_s, float omega_meas_rad_s, float iq_ff_a)
 {
     if ((ctx == 0) || (ctx->dt_s <= 0.0f) || (ctx->iq_limit_a <= 0.0f))
     {
@@ -61,12 +73,17 @@ static inline float FocSpeedCtrl_Step(FocSpeedCtrl *ctx, float omega_ref_rad_s,
     const float p = ctx->kp * e;
     const float i_next = ctx->iq_int_a + (ctx->ki * e * ctx->dt_s);
 
-    const float iq_unsat = p + i_next;
+    const float iq_unsat = p + i_next + iq_ff_a;
     const float iq = FocSpeedCtrl_Clamp(iq_unsat, -ctx->iq_limit_a, ctx->iq_limit_a);
 
     /* anti-windup: back-calculate i-term to match saturated output */
-    ctx->iq_int_a = iq - p;
+    ctx->iq_int_a = iq - p - iq_ff_a;
     return iq;
 }
 
+static inline float FocSpeedCtrl_Step(FocSpeedCtrl *ctx, float omega_ref_rad_s, float omega_meas_rad_s)
+{
+    return FocSpeedCtrl_StepFf(ctx, omega_ref_rad_s, omega_meas_rad_s, 0.0f);
+}
+
 #endif /* COMPONENTS_FOC_SPEED_CTRL_H */
@@ -0,0 +1,214 @@
+#ifndef COMPONENTS_FREQ_RESP_H
+#define COMPONENTS_FREQ_RESP_H
+
+#include <math.h>
+#include <stdint.h>
+
+#ifndef FREQ_RESP_MAX_POINTS
+#define FREQ_RESP_MAX_POINTS (48U)
+#endif
+
+/*
+ * 片上频率响应分析（步进正弦）：
+ * 每个频点注入 amp*sin(phi)，先等 settle 个周期，再在整数个周期内把输入 x、输出 y 分别与 sin/cos 相关：
+ *   X = sum(x*sin) + j*sum(x*cos)，Y 同理，H = Y / X。
+ * 频率按窗口长度取整，使测量窗口恰好是整数个周期（sin/cos 正交，无泄漏）；
+ * sin/cos 用旋转递推（每拍 4 次乘法 + 幅值归一），不在中断里调 sinf。
+ * 每个频点结束只留下 f / 增益 / 相位三个数，由主循环发送。
+ */
+typedef struct
+{
+    float f_hz;
+    float gain;      /* |Y/X| */
+    float phase_deg; /* arg(Y/X)，(-180, 180] */
+} FreqRespPoint;
+
+typedef struct
+{
+    float dt_s;
+    float amp;
+    float f_start_hz;
+    float f_end_hz;
+    uint16_t n_points;
+    uint16_t settle_cycles;
+    uint16_t meas_cycles;
+    float min_settle_s;
+    float min_meas_s;
+
+    uint16_t idx;
+    uint32_t tick;
+    uint32_t settle_ticks;
+    uint32_t meas_ticks;
+    float f_hz; /* 当前频点（取整后） */
+    float c;
+    float s;
+    float rot_c;
+    float rot_s;
+    float acc_xs;
+    float acc_xc;
+    float acc_ys;
+    float acc_yc;
+
+    FreqRespPoint result[FREQ_RESP_MAX_POINTS];
+    uint16_t n_done;
+    uint8_t active;
+} FreqResp;
+
+static inline void FreqResp_Reset(FreqResp *ctx)
+{
+    if (ctx == 0)
+    {
+        return;
+    }
+    ctx->idx = 0U;
+    ctx->tick = 0U;
+    ctx->n_done = 0U;
+    ctx->active = 0U;
+}
+
+/* 配置第 idx 个频点（中断里调用，每个频点一次 sinf/cosf） */
+static inline void FreqResp_SetupPoint(FreqResp *ctx)
+{
+    float f = ctx->f_start_hz;
+    if (ctx->n_points > 1U)
+    {
+        const float k = (float)ctx->idx / (float)(ctx->n_points - 1U);
+        f = ctx->f_start_hz * expf(k * logf(ctx->f_end_hz / ctx->f_start_hz));
+    }
+
+    float cycles = (float)ctx->meas_cycles;
+    if ((f * ctx->min_meas_s) > cycles)
+    {
+        cycles = ceilf(f * ctx->min_meas_s);
+    }
+    float m = floorf((cycles / (f * ctx->dt_s)) + 0.5f);
+    if (m < 1.0f)
+    {
+        m = 1.0f;
+    }
+    ctx->meas_ticks = (uint32_t)m;
+    ctx->f_hz = cycles / (m * ctx->dt_s);
+
+    float settle = ((float)ctx->settle_cycles) / (ctx->f_hz * ctx->dt_s);
+    if (settle < (ctx->min_settle_s / ctx->dt_s))
+    {
+        settle = ctx->min_settle_s / ctx->dt_s;
+    }
+    ctx->settle_ticks = (uint32_t)settle;
+
+    const float w = 6.28318530718f * ctx->f_hz * ctx->dt_s;
+    ctx->rot_c = cosf(w);
+    ctx->rot_s = sinf(w);
+    ctx->c = 1.0f;
+    ctx->s = 0.0f;
+    ctx->tick = 0U;
+    ctx->acc_xs = 0.0f;
+    ctx->acc_xc = 0.0f;
+    ctx->acc_ys = 0.0f;
+    ctx->acc_yc = 0.0f;
+}
+
+/* f_end 会被限制在 0.25/dt 以内（每周期至少 4 个点） */
+static inline void FreqResp_Start(FreqResp *ctx, float amp, float f_start_hz, float f_end_hz, uint16_t n_points,
+                                  uint16_t settle_cycles, uint16_t meas_cycles, float min_settle_s, float min_meas_s,
+                                  float dt_s)
+{
+    if ((ctx == 0) || (dt_s <= 0.0f) || (f_start_hz <= 0.0f) || (f_end_hz < f_start_hz) || (n_points == 0U) ||
+        (meas_cycles == 0U))
+    {
+        return;
+    }
+    const float f_lim = 0.25f / dt_s;
+    ctx->dt_s = dt_s;
+    ctx->amp = amp;
+    ctx->f_start_hz = (f_start_hz < f_lim) ? f_start_hz : f_lim;
+    ctx->f_end_hz = (f_end_hz < f_lim) ? f_end_hz : f_lim;
+    ctx->n_points = (n_points < FREQ_RESP_MAX_POINTS) ? n_points : (uint16_t)FREQ_RESP_MAX_POINTS;
+    ctx->settle_cycles = settle_cycles;
+    ctx->meas_cycles = meas_cycles;
+    ctx->min_settle_s = min_settle_s;
+    ctx->min_meas_s = min_meas_s;
+    ctx->idx = 0U;
+    ctx->n_done = 0U;
+    FreqResp_SetupPoint(ctx);
+    ctx->active = 1U;
+}
+
+static inline void FreqResp_Stop(FreqResp *ctx)
+{
+    if (ctx == 0)
+    {
+        return;
+    }
+    ctx->active = 0U;
+}
+
+/* 本拍注入量 */
+static inline float FreqResp_Inject(const FreqResp *ctx)
+{
+    if ((ctx == 0) || (ctx->active == 0U))
+    {
+        return 0.0f;
+    }
+    return ctx->amp * ctx->s;
+}
+
+/* 每拍在注入生效后调用一次：x 为被测环节输入，y 为输出；随后相位前进一拍 */
+static inline void FreqResp_Accumulate(FreqResp *ctx, float x, float y)
+{
+    if ((ctx == 0) || (ctx->active == 0U))
+    {
+        return;
+    }
+
+    if (ctx->tick >= ctx->settle_ticks)
+    {
+        ctx->acc_xs += x * ctx->s;
+        ctx->acc_xc += x * ctx->c;
+        ctx->acc_ys += y * ctx->s;
+        ctx->acc_yc += y * ctx->c;
+    }
+
+    const float c = (ctx->c * ctx->rot_c) - (ctx->s * ctx->rot_s);
+    const float s = (ctx->s * ctx->rot_c) + (ctx->c * ctx->rot_s);
+    const float k = 1.5f - (0.5f * ((c * c) + (s * s))); /* 幅值一阶归一，防止递推漂移 */
+    ctx->c = c * k;
+    ctx->s = s * k;
+
+    ctx->tick++;
+    if (ctx->tick < (ctx->settle_ticks + ctx->meas_ticks))
+    {
+        return;
+    }
+
+    /* H = Y / X = Y * conj(X) / |X|^2 */
+    const float xr = ctx->acc_xs;
+    const float xi = ctx->acc_xc;
+    const float yr = ctx->acc_ys;
+    const float yi = ctx->acc_yc;
+    const float x2 = (xr * xr) + (xi * xi);
+    FreqRespPoint *pt = &ctx->result[ctx->idx];
+    pt->f_hz = ctx->f_hz;
+    if (x2 > 0.0f)
+    {
+        const float hr = ((yr * xr) + (yi * xi)) / x2;
+        const float hi = ((yi * xr) - (yr * xi)) / x2;
+        pt->gain = sqrtf((hr * hr) + (hi * hi));
+        pt->phase_deg = atan2f(hi, hr) * 57.2957795131f;
+    }
+    else
+    {
+        pt->gain = 0.0f;
+        pt->phase_deg = 0.0f;
+    }
+    ctx->idx++;
+    ctx->n_done = ctx->idx;
+    if (ctx->idx >= ctx->n_points)
+    {
+        ctx->active = 0U;
+        return;
+    }
+    FreqResp_SetupPoint(ctx);
+}
+
+#endif /* COMPONENTS_FREQ_RESP_H */
@@ -0,0 +1,168 @@
+#ifndef COMPONENTS_ISR_TIMING_H
+#define COMPONENTS_ISR_TIMING_H
+
+#include <stdint.h>
+
+/*
+ * 控制中断的截止时间监控，时间单位都是 CPU 周期（DWT->CYCCNT，与 TIM1 计数同一时钟）。
+ * 截止时间 = 下一次 ADC 触发，即本次触发后一个 PWM 周期 P：
+ *   - 出口：t_end = 本次触发到中断退出的时间。只用出口处的定时器相位 el（触发后 [0,P) 内的位置）和入口到出口的耗时 dur，
+ *     入口延迟 < P 时 t_end = ((el - dur) mod P) + dur，> P 即超时，超出部分记为 lateness；
+ *     中断期间 ADC 又完成一次注入序列（上层给 adc_ovr）也算超时。
+ *   - 入口：相邻两次入口间隔 > 1.5P 说明中间丢了触发，按间隔折算丢失的拍数。
+ *     上一拍出口已记过超时的，被它压掉的那次触发已经算过，丢拍数减 1，同一次丢失不重复计数。
+ * lateness 直方图按 P/4 分档：(0, P/4]、(P/4, P/2]、(P/2, P]、> P。
+ * 超时 + 丢拍按窗口（win_ticks 次出口）统计，窗口内一超过 rate_limit 就置位，直到某个完整窗口不超过才清除。
+ */
+#define ISR_TIMING_HIST_N (4U)
+
+typedef struct
+{
+    uint32_t period_cyc;
+    uint32_t win_ticks;
+    uint32_t rate_limit;
+
+    uint32_t entry_cyc;
+    uint8_t have_entry;
+    uint8_t last_overrun; /* 上一拍出口记过超时 */
+
+    uint32_t overrun_count; /* 出口超过截止时间（或中断期间又来一次转换）的次数 */
+    uint32_t miss_count;    /* 入口间隔推算出的丢失拍数 */
+    uint32_t late_hist[ISR_TIMING_HIST_N];
+    uint32_t late_max_cyc;
+    uint32_t t_end_cyc;         /* 最近一拍 */
+    uint32_t t_end_max_cyc;     /* 上电以来最大 */
+    uint32_t t_end_win_max_cyc; /* 上一个完整窗口内最大 */
+
+    uint32_t win_n;
+    uint32_t win_events;
+    uint32_t win_t_end_max;
+    uint32_t win_rate; /* 上一个完整窗口的超时 + 丢拍数 */
+    uint8_t rate_high;
+} IsrTiming;
+
+static inline void IsrTiming_Init(IsrTiming *ctx, uint32_t period_cyc, uint32_t win_ticks, uint32_t rate_limit)
+{
+    if ((ctx == 0) || (period_cyc == 0U) || (win_ticks == 0U))
+    {
+        return;
+    }
+    ctx->period_cyc = period_cyc;
+    ctx->win_ticks = win_ticks;
+    ctx->rate_limit = rate_limit;
+    ctx->have_entry = 0U;
+    ctx->last_overrun = 0U;
+    ctx->overrun_count = 0U;
+    ctx->miss_count = 0U;
+    for (uint8_t i = 0U; i < ISR_TIMING_HIST_N; ++i)
+    {
+        ctx->late_hist[i] = 0U;
+    }
+    ctx->late_max_cyc = 0U;
+    ctx->t_end_cyc = 0U;
+    ctx->t_end_max_cyc = 0U;
+    ctx->t_end_win_max_cyc = 0U;
+    ctx->win_n = 0U;
+    ctx->win_events = 0U;
+    ctx->win_t_end_max = 0U;
+    ctx->win_rate = 0U;
+    ctx->rate_high = 0U;
+}
+
+/* 中断入口，返回本次推算出的丢失拍数 */
+static inline uint32_t IsrTiming_Entry(IsrTiming *ctx, uint32_t cyc)
+{
+    if ((ctx == 0) || (ctx->period_cyc == 0U))
+    {
+        return 0U;
+    }
+    uint32_t missed = 0U;
+    if (ctx->have_entry != 0U)
+    {
+        const uint32_t gap = cyc - ctx->entry_cyc;
+        if (gap > (ctx->period_cyc + (ctx->period_cyc >> 1)))
+        {
+            missed = ((gap + (ctx->period_cyc >> 1)) / ctx->period_cyc) - 1U;
+            if (ctx->last_overrun != 0U)
+            {
+                missed--;
+            }
+            ctx->miss_count += missed;
+            ctx->win_events += missed;
+        }
+    }
+    ctx->entry_cyc = cyc;
+    ctx->have_entry = 1U;
+    ctx->last_overrun = 0U;
+    return missed;
+}
+
+/*
+ * 中断出口：el_cyc 为出口时刻相对本次触发的定时器相位（[0, P)），cyc 为出口 CYCCNT，adc_ovr 为中断期间又完成了转换。
+ * 返回 rate_high：超时/丢拍频度超过上限。
+ */
+static inline uint8_t IsrTiming_Exit(IsrTiming *ctx, uint32_t el_cyc, uint32_t cyc, uint8_t adc_ovr)
+{
+    if ((ctx == 0) || (ctx->period_cyc == 0U))
+    {
+        return 0U;
+    }
+    const uint32_t p = ctx->period_cyc;
+    const uint32_t dur = cyc - ctx->entry_cyc;
+    const uint32_t dur_mod = dur % p;
+    const uint32_t lat_in = (el_cyc >= dur_mod) ? (el_cyc - dur_mod) : ((el_cyc + p) - dur_mod);
+    const uint32_t t_end = lat_in + dur;
+    ctx->t_end_cyc = t_end;
+    if (t_end > ctx->t_end_max_cyc)
+    {
+        ctx->t_end_max_cyc = t_end;
+    }
+    if (t_end > ctx->win_t_end_max)
+    {
+        ctx->win_t_end_max = t_end;
+    }
+
+    if ((t_end > p) || (adc_ovr != 0U))
+    {
+        const uint32_t late = (t_end > p) ? (t_end - p) : 0U;
+        uint8_t b = 3U;
+        if (late <= (p >> 2))
+        {
+            b = 0U;
+        }
+        else if (late <= (p >> 1))
+        {
+            b = 1U;
+        }
+        else if (late <= p)
+        {
+            b = 2U;
+        }
+        ctx->late_hist[b]++;
+        if (late > ctx->late_max_cyc)
+        {
+            ctx->late_max_cyc = late;
+        }
+        ctx->overrun_count++;
+        ctx->win_events++;
+        ctx->last_overrun = 1U;
+    }
+    if (ctx->win_events > ctx->rate_limit)
+    {
+        ctx->rate_high = 1U;
+    }
+
+    ctx->win_n++;
+    if (ctx->win_n >= ctx->win_ticks)
+    {
+        ctx->win_rate = ctx->win_events;
+        ctx->t_end_win_max_cyc = ctx->win_t_end_max;
+        ctx->rate_high = (ctx->win_events > ctx->rate_limit) ? 1U : 0U;
+        ctx->win_n = 0U;
+        ctx->win_events = 0U;
+        ctx->win_t_end_max = 0U;
+    }
+    return ctx->rate_high;
+}
+
+#endif /* COMPONENTS_ISR_TIMING_H */
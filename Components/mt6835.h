@@ -6,6 +6,15 @@
 #define MT6835_STREAM_CMD_H (0xA0U)
 #define MT6835_STREAM_CMD_L (0x03U)
 
+/* 角度帧第 3 字节低 3 位 STATUS[2:0] */
+#define MT6835_STATUS_OVER_SPEED (0x01U)    /* 转速超出芯片跟踪范围 */
+#define MT6835_STATUS_MAG_WEAK (0x02U)      /* 磁场过弱（磁铁距离/偏心） */
+#define MT6835_STATUS_UNDER_VOLTAGE (0x04U) /* 供电欠压 */
+#define MT6835_STATUS_MASK (0x07U)
+
+/* 连续读角度的数据帧：ANGLE[20:13] / ANGLE[12:5] / ANGLE[4:0]+STATUS[2:0] / CRC8 */
+#define MT6835_ANGLE_FRAME_LEN (4U)
+
 typedef struct
 {
     void *user;
@@ -25,6 +34,8 @@ uint32_t Mt6835_ReadRaw21(Mt6835 *ctx);
 uint8_t Mt6835_ReadReg8(Mt6835 *ctx, uint16_t reg, uint8_t *val_out);
 uint8_t Mt6835_WriteReg8(Mt6835 *ctx, uint16_t reg, uint8_t val);
 uint8_t Mt6835_BurnEeprom(Mt6835 *ctx, uint8_t *ack_out);
+uint8_t Mt6835_Crc8(const uint8_t *data, uint32_t len);
+uint8_t Mt6835_DecodeAngleFrame(const uint8_t frame[MT6835_ANGLE_FRAME_LEN], uint32_t *raw21_out, uint8_t *status_out);
 float Mt6835_Raw21ToRad(uint32_t raw21);
 float Mt6835_Raw21ToDeg(uint32_t raw21);
 
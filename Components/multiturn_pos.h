@@ -0,0 +1,53 @@
+#ifndef COMPONENTS_MULTITURN_POS_H
+#define COMPONENTS_MULTITURN_POS_H
+
+#include <stdint.h>
+
+/* MT6835 21 位单圈计数 */
+#define MULTITURN_POS_COUNTS_PER_REV (2097152L)
+#define MULTITURN_POS_RAD_PER_COUNT (6.28318530718f / 2097152.0f)
+
+/*
+ * 多圈位置累加：每次用 raw21 与上一次的差值（按 21 位补码取最短路径，要求两次之间转过不到半圈）累加到 64 位计数。
+ * 首帧直接以 raw21 为起点，上电后的位置 = 单圈绝对角度 + 圈数。
+ */
+typedef struct
+{
+    int64_t count;
+    uint32_t last_raw21;
+    uint8_t valid;
+} MultiTurnPos;
+
+static inline void MultiTurnPos_Reset(MultiTurnPos *ctx)
+{
+    if (ctx == 0)
+    {
+        return;
+    }
+    ctx->count = 0;
+    ctx->last_raw21 = 0U;
+    ctx->valid = 0U;
+}
+
+static inline void MultiTurnPos_Update(MultiTurnPos *ctx, uint32_t raw21)
+{
+    if (ctx == 0)
+    {
+        return;
+    }
+    raw21 &= 0x1FFFFFU;
+    if (ctx->valid == 0U)
+    {
+        ctx->count = (int64_t)raw21;
+        ctx->last_raw21 = raw21;
+        ctx->valid = 1U;
+        return;
+    }
+
+    /* 左移 11 位到 int32 符号位，再算术右移回来：21 位差值的符号扩展 */
+    const int32_t delta = ((int32_t)((raw21 - ctx->last_raw21) << 11)) >> 11;
+    ctx->count += (int64_t)delta;
+    ctx->last_raw21 = raw21;
+}
+
+#endif /* COMPONENTS_MULTITURN_POS_H */
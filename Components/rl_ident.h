@@ -0,0 +1,344 @@
+#ifndef COMPONENTS_RL_IDENT_H
+#define COMPONENTS_RL_IDENT_H
+
+#include <math.h>
+#include <stdint.h>
+
+/*
+ * 静止 R / Ld / Lq 辨识（电流环自整定用）：
+ * 1) R：电流环把 Id 依次稳在 i1、i2，各自平均 ud，R = (ud2 - ud1) / (id2 - id1)，两点作差消掉死区/管压降的常值部分；
+ * 2) Ld：电流环退出，ud = ud1 + du*PRBS（du = R*di），uq 保持 i1 时的平均值，逐拍记录 id；
+ * 3) Lq：ud 保持 ud1（Id 偏置把转子锁住），uq = uq1 + du*PRBS，逐拍记录 iq（零均值注入，转子基本不动）。
+ * 电感段按去偏置后的离散模型 x[k+1] = a*x[k] + b0*u[k] + b1*u[k-1] + c 做最小二乘，
+ * 同时容忍 0/1 拍计算延时；tau = -dt/ln(a)，L = R*tau。
+ */
+typedef enum
+{
+    RL_IDENT_IDLE = 0,
+    RL_IDENT_RUN,
+    RL_IDENT_DONE,
+    RL_IDENT_FAIL,
+} RlIdentState;
+
+typedef enum
+{
+    RL_IDENT_PH_R1 = 0,
+    RL_IDENT_PH_R2,
+    RL_IDENT_PH_LD,
+    RL_IDENT_PH_LQ,
+} RlIdentPhase;
+
+#define RL_IDENT_NP (4U)
+
+typedef struct
+{
+    RlIdentState state;
+    RlIdentPhase phase;
+    float i1_a;
+    float i2_a;
+    float di_a; /* 电感段注入幅值（电流） */
+    float dt_s;
+    uint32_t settle_ticks;
+    uint32_t avg_ticks;
+    uint32_t inj_ticks;
+
+    uint32_t tick;
+    float acc_id;
+    float acc_ud;
+    float acc_uq;
+    float ud1_v;
+    float uq1_v;
+    float id1_a;
+    float du_v;
+
+    /* 注入 */
+    uint8_t lfsr;
+    float u_prev;  /* u[k-1]（去偏置） */
+    float u_cur;   /* u[k]，本拍下发 */
+    float x_prev;  /* x[k]（去偏置） */
+    uint8_t x_valid;
+
+    /* 正规方程 [x u u_prev 1]' [..] 与右端 */
+    float m[RL_IDENT_NP][RL_IDENT_NP];
+    float v[RL_IDENT_NP];
+
+    float r_ohm;
+    float ld_h;
+    float lq_h;
+} RlIdent;
+
+static inline void RlIdent_ClearLs(RlIdent *ctx)
+{
+    for (uint8_t i = 0U; i < RL_IDENT_NP; ++i)
+    {
+        ctx->v[i] = 0.0f;
+        for (uint8_t j = 0U; j < RL_IDENT_NP; ++j)
+        {
+            ctx->m[i][j] = 0.0f;
+        }
+    }
+    ctx->u_prev = 0.0f;
+    ctx->u_cur = 0.0f;
+    ctx->x_prev = 0.0f;
+    ctx->x_valid = 0U;
+    ctx->tick = 0U;
+}
+
+static inline void RlIdent_Start(RlIdent *ctx, float i1_a, float i2_a, float di_a, float dt_s, uint32_t settle_ticks,
+                                 uint32_t avg_ticks, uint32_t inj_ticks)
+{
+    if ((ctx == 0) || (i2_a <= i1_a) || (i1_a <= 0.0f) || (di_a <= 0.0f) || (dt_s <= 0.0f) || (avg_ticks == 0U) ||
+        (inj_ticks == 0U))
+    {
+        return;
+    }
+    ctx->i1_a = i1_a;
+    ctx->i2_a = i2_a;
+    ctx->di_a = di_a;
+    ctx->dt_s = dt_s;
+    ctx->settle_ticks = settle_ticks;
+    ctx->avg_ticks = avg_ticks;
+    ctx->inj_ticks = inj_ticks;
+    ctx->acc_id = 0.0f;
+    ctx->acc_ud = 0.0f;
+    ctx->acc_uq = 0.0f;
+    ctx->ud1_v = 0.0f;
+    ctx->uq1_v = 0.0f;
+    ctx->id1_a = 0.0f;
+    ctx->du_v = 0.0f;
+    ctx->lfsr = 0x5AU;
+    ctx->r_ohm = 0.0f;
+    ctx->ld_h = 0.0f;
+    ctx->lq_h = 0.0f;
+    RlIdent_ClearLs(ctx);
+    ctx->phase = RL_IDENT_PH_R1;
+    ctx->state = RL_IDENT_RUN;
+}
+
+static inline void RlIdent_Abort(RlIdent *ctx)
+{
+    if (ctx == 0)
+    {
+        return;
+    }
+    ctx->state = RL_IDENT_IDLE;
+}
+
+/* 1=当前阶段由电流环闭环（用 RlIdent_IdRef），0=开环注入（用 RlIdent_TickInject 给出的电压） */
+static inline uint8_t RlIdent_PiPhase(const RlIdent *ctx)
+{
+    return ((ctx != 0) && ((ctx->phase == RL_IDENT_PH_R1) || (ctx->phase == RL_IDENT_PH_R2))) ? 1U : 0U;
+}
+
+static inline float RlIdent_IdRef(const RlIdent *ctx)
+{
+    if ((ctx == 0) || (ctx->state != RL_IDENT_RUN))
+    {
+        return 0.0f;
+    }
+    return (ctx->phase == RL_IDENT_PH_R2) ? ctx->i2_a : ctx->i1_a;
+}
+
+/* 闭环阶段每 tick 调用：id 与电流环本拍输出电压 */
+static inline void RlIdent_TickPi(RlIdent *ctx, float id_a, float ud_v, float uq_v)
+{
+    if ((ctx == 0) || (ctx->state != RL_IDENT_RUN) || (RlIdent_PiPhase(ctx) == 0U))
+    {
+        return;
+    }
+    ctx->tick++;
+    if (ctx->tick <= ctx->settle_ticks)
+    {
+        return;
+    }
+    ctx->acc_id += id_a;
+    ctx->acc_ud += ud_v;
+    ctx->acc_uq += uq_v;
+    if (ctx->tick < (ctx->settle_ticks + ctx->avg_ticks))
+    {
+        return;
+    }
+
+    const float inv_n = 1.0f / (float)ctx->avg_ticks;
+    const float id = ctx->acc_id * inv_n;
+    const float ud = ctx->acc_ud * inv_n;
+    const float uq = ctx->acc_uq * inv_n;
+    ctx->acc_id = 0.0f;
+    ctx->acc_ud = 0.0f;
+    ctx->acc_uq = 0.0f;
+    ctx->tick = 0U;
+
+    if (ctx->phase == RL_IDENT_PH_R1)
+    {
+        ctx->id1_a = id;
+        ctx->ud1_v = ud;
+        ctx->uq1_v = uq;
+        ctx->phase = RL_IDENT_PH_R2;
+        return;
+    }
+
+    const float d_i = id - ctx->id1_a;
+    if (d_i < (0.25f * (ctx->i2_a - ctx->i1_a)))
+    {
+        ctx->state = RL_IDENT_FAIL;
+        return;
+    }
+    ctx->r_ohm = (ud - ctx->ud1_v) / d_i;
+    if (ctx->r_ohm <= 0.0f)
+    {
+        ctx->state = RL_IDENT_FAIL;
+        return;
+    }
+    ctx->du_v = ctx->r_ohm * ctx->di_a;
+    RlIdent_ClearLs(ctx);
+    ctx->phase = RL_IDENT_PH_LD;
+}
+
+/* 4x4 正规方程求解（列主元消元），失败返回 0 */
+static inline uint8_t RlIdent_Solve(float m[RL_IDENT_NP][RL_IDENT_NP], float v[RL_IDENT_NP], float th[RL_IDENT_NP])
+{
+    for (uint8_t c = 0U; c < RL_IDENT_NP; ++c)
+    {
+        uint8_t p = c;
+        for (uint8_t r = (uint8_t)(c + 1U); r < RL_IDENT_NP; ++r)
+        {
+            if (fabsf(m[r][c]) > fabsf(m[p][c]))
+            {
+                p = r;
+            }
+        }
+        if (fabsf(m[p][c]) < 1.0e-12f)
+        {
+            return 0U;
+        }
+        if (p != c)
+        {
+            for (uint8_t k = 0U; k < RL_IDENT_NP; ++k)
+            {
+                const float t = m[c][k];
+                m[c][k] = m[p][k];
+                m[p][k] = t;
+            }
+            const float t = v[c];
+            v[c] = v[p];
+            v[p] = t;
+        }
+        for (uint8_t r = (uint8_t)(c + 1U); r < RL_IDENT_NP; ++r)
+        {
+            const float f = m[r][c] / m[c][c];
+            for (uint8_t k = c; k < RL_IDENT_NP; ++k)
+            {
+                m[r][k] -= f * m[c][k];
+            }
+            v[r] -= f * v[c];
+        }
+    }
+    for (int8_t r = (int8_t)(RL_IDENT_NP - 1U); r >= 0; --r)
+    {
+        float s = v[r];
+        for (uint8_t k = (uint8_t)(r + 1); k < RL_IDENT_NP; ++k)
+        {
+            s -= m[r][k] * th[k];
+        }
+        th[r] = s / m[r][r];
+    }
+    return 1U;
+}
+
+/* 由拟合结果求电感；a 不在 (0,1) 或增益非正判失败 */
+static inline float RlIdent_FitL(RlIdent *ctx)
+{
+    float th[RL_IDENT_NP] = {0.0f};
+    if (RlIdent_Solve(ctx->m, ctx->v, th) == 0U)
+    {
+        return 0.0f;
+    }
+    const float a = th[0];
+    const float b = th[1] + th[2];
+    if ((a <= 0.0f) || (a >= 1.0f) || (b <= 0.0f))
+    {
+        return 0.0f;
+    }
+    return ctx->r_ohm * (-ctx->dt_s / logf(a));
+}
+
+/*
+ * 注入阶段每 tick 调用：id/iq 为本拍实测电流，返回下一次下发的 ud/uq（V）。
+ * 调用前 *ud_v / *uq_v 内容无意义。
+ */
+static inline void RlIdent_TickInject(RlIdent *ctx, float id_a, float iq_a, float *ud_v, float *uq_v)
+{
+    if ((ctx == 0) || (ud_v == 0) || (uq_v == 0))
+    {
+        return;
+    }
+    *ud_v = ctx->ud1_v;
+    *uq_v = ctx->uq1_v;
+    if ((ctx->state != RL_IDENT_RUN) || (RlIdent_PiPhase(ctx) != 0U))
+    {
+        return;
+    }
+
+    const uint8_t q_axis = (ctx->phase == RL_IDENT_PH_LQ) ? 1U : 0U;
+    const float x = (q_axis != 0U) ? iq_a : (id_a - ctx->id1_a);
+
+    /* 先让偏置电流稳定（d 轴开环保持 ud1），再开始注入和记录 */
+    if (ctx->tick < ctx->settle_ticks)
+    {
+        ctx->tick++;
+        ctx->x_prev = x;
+        return;
+    }
+
+    if (ctx->x_valid != 0U)
+    {
+        const float phi[RL_IDENT_NP] = {ctx->x_prev, ctx->u_cur, ctx->u_prev, 1.0f};
+        for (uint8_t i = 0U; i < RL_IDENT_NP; ++i)
+        {
+            ctx->v[i] += phi[i] * x;
+            for (uint8_t j = 0U; j < RL_IDENT_NP; ++j)
+            {
+                ctx->m[i][j] += phi[i] * phi[j];
+            }
+        }
+    }
+    ctx->x_prev = x;
+    ctx->x_valid = 1U;
+    ctx->tick++;
+
+    if (ctx->tick >= (ctx->settle_ticks + ctx->inj_ticks))
+    {
+        const float l = RlIdent_FitL(ctx);
+        if (l <= 0.0f)
+        {
+            ctx->state = RL_IDENT_FAIL;
+            return;
+        }
+        if (q_axis == 0U)
+        {
+            ctx->ld_h = l;
+            RlIdent_ClearLs(ctx);
+            ctx->phase = RL_IDENT_PH_LQ;
+            return;
+        }
+        ctx->lq_h = l;
+        ctx->state = RL_IDENT_DONE;
+        return;
+    }
+
+    /* PRBS7（x^7 + x^6 + 1），每拍一位 */
+    const uint8_t bit = (uint8_t)(((ctx->lfsr >> 6U) ^ (ctx->lfsr >> 5U)) & 1U);
+    ctx->lfsr = (uint8_t)(((ctx->lfsr << 1U) | bit) & 0x7FU);
+    ctx->u_prev = ctx->u_cur;
+    ctx->u_cur = (bit != 0U) ? ctx->du_v : -ctx->du_v;
+    if (q_axis != 0U)
+    {
+        *uq_v = ctx->uq1_v + ctx->u_cur;
+    }
+    else
+    {
+        *ud_v = ctx->ud1_v + ctx->u_cur;
+    }
+}
+
+#endif /* COMPONENTS_RL_IDENT_H */
@@ -0,0 +1,91 @@
+#ifndef COMPONENTS_RLS_EST_H
+#define COMPONENTS_RLS_EST_H
+
+#include <stdint.h>
+
+/*
+ * 两参数递推最小二乘（带遗忘因子），y = phi0*theta0 + phi1*theta1：
+ *   k = P*phi / (lambda + phi'*P*phi)
+ *   theta += k * (y - phi'*theta)
+ *   P = (P - k*phi'*P) / lambda
+ * 激励不足的方向上 P 会按 1/lambda 一直长（估计值随噪声漂），所以：
+ *   1) 是否更新由调用方按激励条件判断（没激励就不调 Update，P 和 theta 都冻结）；
+ *   2) trace(P) 超过上限时整体缩回上限。
+ * 调用方负责把 phi / theta 缩放到同一量级（float）。主循环里用，不在中断里跑。
+ */
+#define RLS_EST_NP (2U)
+
+typedef struct
+{
+    float lambda;
+    float p0;
+    float p_trace_max;
+
+    float theta[RLS_EST_NP];
+    float p[RLS_EST_NP][RLS_EST_NP];
+    float err; /* 最近一次的先验误差 */
+    uint32_t n_upd;
+} RlsEst2;
+
+static inline void RlsEst2_Reset(RlsEst2 *ctx, float theta0, float theta1)
+{
+    if (ctx == 0)
+    {
+        return;
+    }
+    ctx->theta[0] = theta0;
+    ctx->theta[1] = theta1;
+    ctx->p[0][0] = ctx->p0;
+    ctx->p[0][1] = 0.0f;
+    ctx->p[1][0] = 0.0f;
+    ctx->p[1][1] = ctx->p0;
+    ctx->err = 0.0f;
+    ctx->n_upd = 0U;
+}
+
+static inline void RlsEst2_Init(RlsEst2 *ctx, float lambda, float p0, float p_trace_max, float theta0, float theta1)
+{
+    if ((ctx == 0) || (lambda <= 0.0f) || (lambda > 1.0f) || (p0 <= 0.0f) || (p_trace_max < p0))
+    {
+        return;
+    }
+    ctx->lambda = lambda;
+    ctx->p0 = p0;
+    ctx->p_trace_max = p_trace_max;
+    RlsEst2_Reset(ctx, theta0, theta1);
+}
+
+static inline void RlsEst2_Update(RlsEst2 *ctx, float phi0, float phi1, float y)
+{
+    if ((ctx == 0) || (ctx->lambda <= 0.0f))
+    {
+        return;
+    }
+    const float pphi0 = (ctx->p[0][0] * phi0) + (ctx->p[0][1] * phi1);
+    const float pphi1 = (ctx->p[1][0] * phi0) + (ctx->p[1][1] * phi1);
+    const float den = ctx->lambda + (phi0 * pphi0) + (phi1 * pphi1);
+    if (den <= 0.0f)
+    {
+        return;
+    }
+    const float inv_den = 1.0f / den;
+    const float e = y - ((phi0 * ctx->theta[0]) + (phi1 * ctx->theta[1]));
+    ctx->theta[0] += pphi0 * inv_den * e;
+    ctx->theta[1] += pphi1 * inv_den * e;
+
+    /* P 对称，P*phi 转置即 phi'*P；按对称式更新避免舍入后不对称 */
+    const float inv_lambda = 1.0f / ctx->lambda;
+    const float p00 = (ctx->p[0][0] - (pphi0 * pphi0 * inv_den)) * inv_lambda;
+    const float p01 = (ctx->p[0][1] - (pphi0 * pphi1 * inv_den)) * inv_lambda;
+    const float p11 = (ctx->p[1][1] - (pphi1 * pphi1 * inv_den)) * inv_lambda;
+    const float tr = p00 + p11;
+    const float k = (tr > ctx->p_trace_max) ? (ctx->p_trace_max / tr) : 1.0f;
+    ctx->p[0][0] = p00 * k;
+    ctx->p[0][1] = p01 * k;
+    ctx->p[1][0] = p01 * k;
+    ctx->p[1][1] = p11 * k;
+    ctx->err = e;
+    ctx->n_upd++;
+}
+
+#endif /* COMPONENTS_RLS_EST_H */
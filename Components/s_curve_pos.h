@@ -0,0 +1,183 @@
+#ifndef COMPONENTS_S_CURVE_POS_H
+#define COMPONENTS_S_CURVE_POS_H
+
+#include <math.h>
+#include <stdint.h>
+
+/*
+ * 七段 S 曲线点到点轨迹（静止到静止，时间最优）：
+ *   加加速度依次为 +J, 0, -J, 0, -J, 0, +J，减速段与加速段对称。
+ * Plan 在慢速上下文里按距离 / v_max / a_max / j_max 算出各段时长和段起点状态（只做一次）；
+ * Step 在控制节拍里推进时间，按当前段的三次多项式直接求 pos / vel / acc（O(1)）。
+ * 距离不够时依次降低峰值速度、峰值加速度（达不到 a_max 时加速段只剩两段加加速度）。
+ */
+#define S_CURVE_POS_SEGS (7U)
+
+typedef struct
+{
+    float dt_s;
+    float dir; /* 移动方向 ±1，段内状态都按正方向存 */
+    float dist;
+    float jerk;
+    float v_peak;
+    float a_peak;
+    float t_seg[S_CURVE_POS_SEGS + 1U]; /* 各段起点时刻，t_seg[7] = 总时长 */
+    float p_seg[S_CURVE_POS_SEGS];
+    float v_seg[S_CURVE_POS_SEGS];
+    float a_seg[S_CURVE_POS_SEGS];
+
+    float t;
+    uint8_t seg;
+    uint8_t active;
+    float pos; /* 相对起点，带方向 */
+    float vel;
+    float acc;
+} SCurvePos;
+
+static inline void SCurvePos_Reset(SCurvePos *ctx)
+{
+    if (ctx == 0)
+    {
+        return;
+    }
+    ctx->t = 0.0f;
+    ctx->seg = 0U;
+    ctx->active = 0U;
+    ctx->pos = 0.0f;
+    ctx->vel = 0.0f;
+    ctx->acc = 0.0f;
+}
+
+static inline float SCurvePos_SegJerk(const SCurvePos *ctx, uint8_t seg)
+{
+    switch (seg)
+    {
+    case 0U:
+    case 6U:
+        return ctx->jerk;
+    case 2U:
+    case 4U:
+        return -ctx->jerk;
+    default:
+        return 0.0f;
+    }
+}
+
+/* 规划一次移动（dist 带符号）；返回 0 表示参数无效或距离为 0，此时轨迹停在起点 */
+static inline uint8_t SCurvePos_Plan(SCurvePos *ctx, float dist, float v_max, float a_max, float j_max, float dt_s)
+{
+    if (ctx == 0)
+    {
+        return 0U;
+    }
+    SCurvePos_Reset(ctx);
+    if ((v_max <= 0.0f) || (a_max <= 0.0f) || (j_max <= 0.0f) || (dt_s <= 0.0f) || (dist == 0.0f))
+    {
+        return 0U;
+    }
+
+    const float d = fabsf(dist);
+    float a = a_max;
+    float v = v_max;
+    if ((v * j_max) < (a * a))
+    {
+        /* v_max 在加速度到顶前就到了 */
+        a = sqrtf(v * j_max);
+    }
+    float t_acc = (v / a) + (a / j_max); /* 0 -> v 的总时长 */
+    float t_cruise = 0.0f;
+    if (d >= (v * t_acc))
+    {
+        t_cruise = (d - (v * t_acc)) / v;
+    }
+    else
+    {
+        /* 到不了 v_max：先试保留 a_max 的峰值速度，d = v^2/a + v*a/j */
+        const float a2j = (a_max * a_max) / j_max;
+        v = 0.5f * (-a2j + sqrtf((a2j * a2j) + (4.0f * a_max * d)));
+        a = a_max;
+        if (v < a2j)
+        {
+            /* 加速度也到不了顶：d = 2 * v^1.5 / sqrt(j) */
+            v = cbrtf(0.25f * d * d * j_max);
+            a = sqrtf(v * j_max);
+        }
+        t_acc = (v / a) + (a / j_max);
+    }
+
+    const float tj = a / j_max;
+    float ta = t_acc - (2.0f * tj);
+    if (ta < 0.0f)
+    {
+        ta = 0.0f;
+    }
+    const float dur[S_CURVE_POS_SEGS] = {tj, ta, tj, t_cruise, tj, ta, tj};
+
+    ctx->dt_s = dt_s;
+    ctx->dir = (dist > 0.0f) ? 1.0f : -1.0f;
+    ctx->dist = d;
+    ctx->jerk = j_max;
+    ctx->v_peak = v;
+    ctx->a_peak = a;
+
+    float t = 0.0f;
+    float p = 0.0f;
+    float vv = 0.0f;
+    float aa = 0.0f;
+    for (uint8_t i = 0U; i < S_CURVE_POS_SEGS; ++i)
+    {
+        ctx->t_seg[i] = t;
+        ctx->p_seg[i] = p;
+        ctx->v_seg[i] = vv;
+        ctx->a_seg[i] = aa;
+
+        const float h = dur[i];
+        const float jk = SCurvePos_SegJerk(ctx, i);
+        p += (vv * h) + (0.5f * aa * h * h) + ((jk / 6.0f) * h * h * h);
+        vv += (aa * h) + (0.5f * jk * h * h);
+        aa += jk * h;
+        t += h;
+    }
+    ctx->t_seg[S_CURVE_POS_SEGS] = t;
+    ctx->active = 1U;
+    return 1U;
+}
+
+static inline float SCurvePos_Duration(const SCurvePos *ctx)
+{
+    return (ctx != 0) ? ctx->t_seg[S_CURVE_POS_SEGS] : 0.0f;
+}
+
+/* 每个控制节拍调用一次：时间前进 dt，更新 pos / vel / acc；走完后停在终点 */
+static inline void SCurvePos_Step(SCurvePos *ctx)
+{
+    if ((ctx == 0) || (ctx->active == 0U))
+    {
+        return;
+    }
+
+    ctx->t += ctx->dt_s;
+    if (ctx->t >= ctx->t_seg[S_CURVE_POS_SEGS])
+    {
+        ctx->pos = ctx->dir * ctx->dist;
+        ctx->vel = 0.0f;
+        ctx->acc = 0.0f;
+        ctx->active = 0U;
+        return;
+    }
+    while ((ctx->seg < (S_CURVE_POS_SEGS - 1U)) && (ctx->t >= ctx->t_seg[ctx->seg + 1U]))
+    {
+        ctx->seg++;
+    }
+
+    const uint8_t k = ctx->seg;
+    const float h = ctx->t - ctx->t_seg[k];
+    const float jk = SCurvePos_SegJerk(ctx, k);
+    const float a0 = ctx->a_seg[k];
+    const float v0 = ctx->v_seg[k];
+    ctx->pos = ctx->dir * (ctx->p_seg[k] + (v0 * h) + (0.5f * a0 * h * h) + ((jk / 6.0f) * h * h * h));
+    ctx->vel = ctx->dir * (v0 + (a0 * h) + (0.5f * jk * h * h));
+    ctx->acc = ctx->dir * (a0 + (jk * h));
+}
+
+#endif /* COMPONENTS_S_CURVE_POS_H */
@@ -28,4 +28,60 @@
 #define MOTORAPP_LOG_SWEEP_DURATION_S (20.0f)
 #endif
 
+/* ========= MotorApp: on-chip frequency response analyzer (stepped sine) =========
+ *
+ * Used by HostCmd `H<pt>` in MotorApp. Runs at CTRL_HZ; f_end is capped at CTRL_HZ/4
+ * (MOTORAPP_FRA_F_END_SPD_HZ for the speed-reference point).
+ */
+
+#ifndef MOTORAPP_FRA_F_START_HZ
+#define MOTORAPP_FRA_F_START_HZ (5.0f)
+#endif
+
+#ifndef MOTORAPP_FRA_F_END_HZ
+#define MOTORAPP_FRA_F_END_HZ (5000.0f)
+#endif
+
+/* H3 (omega_ref) only changes at the speed-loop tick: cap at SPEED_LOOP_HZ/4 (1 kHz / 4) */
+#ifndef MOTORAPP_FRA_F_END_SPD_HZ
+#define MOTORAPP_FRA_F_END_SPD_HZ (250.0f)
+#endif
+
+#ifndef MOTORAPP_FRA_POINTS
+#define MOTORAPP_FRA_POINTS (40U)
+#endif
+
+#ifndef MOTORAPP_FRA_SETTLE_CYCLES
+#define MOTORAPP_FRA_SETTLE_CYCLES (4U)
+#endif
+
+#ifndef MOTORAPP_FRA_MEAS_CYCLES
+#define MOTORAPP_FRA_MEAS_CYCLES (8U)
+#endif
+
+#ifndef MOTORAPP_FRA_MIN_SETTLE_S
+#define MOTORAPP_FRA_MIN_SETTLE_S (0.02f)
+#endif
+
+#ifndef MOTORAPP_FRA_MIN_MEAS_S
+#define MOTORAPP_FRA_MIN_MEAS_S (0.05f)
+#endif
+
+/* injection amplitude per loop point */
+#ifndef MOTORAPP_FRA_AMP_ID_A
+#define MOTORAPP_FRA_AMP_ID_A (0.2f)
+#endif
+
+#ifndef MOTORAPP_FRA_AMP_IQ_A
+#define MOTORAPP_FRA_AMP_IQ_A (0.1f)
+#endif
+
+#ifndef MOTORAPP_FRA_AMP_SPD_RAD_S
+#define MOTORAPP_FRA_AMP_SPD_RAD_S (5.0f)
+#endif
+
+#ifndef MOTORAPP_FRA_AMP_UD_V
+#define MOTORAPP_FRA_AMP_UD_V (0.1f)
+#endif
+
 #endif /* COMPONENTS_SIGNAL_CONFIG_H */
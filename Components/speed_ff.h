@@ -0,0 +1,74 @@
+#ifndef COMPONENTS_SPEED_FF_H
+#define COMPONENTS_SPEED_FF_H
+
+#include <stdint.h>
+
+/*
+ * 速度环 Iq 前馈（按给定轨迹，不用实测量）：
+ *   iq_ff = (J*a + B*omega + Tc*sign(omega)) / Kt
+ * 库仑项在 |omega| < omega_band 内线性过渡，避免零速附近来回跳。
+ * 三项分开保存，便于看各自贡献；系数可运行时改（主循环写、中断读，单个 float 写入是原子的）。
+ */
+typedef struct
+{
+    float j_kgm2;
+    float b_nms;
+    float tc_nm;
+    float kt_nm_a;
+    float omega_band_rad_s;
+
+    float iq_acc_a;
+    float iq_visc_a;
+    float iq_coul_a;
+} SpeedFf;
+
+static inline void SpeedFf_Init(SpeedFf *ctx, float j_kgm2, float b_nms, float tc_nm, float kt_nm_a,
+                                float omega_band_rad_s)
+{
+    if ((ctx == 0) || (kt_nm_a <= 0.0f))
+    {
+        return;
+    }
+    ctx->j_kgm2 = j_kgm2;
+    ctx->b_nms = b_nms;
+    ctx->tc_nm = tc_nm;
+    ctx->kt_nm_a = kt_nm_a;
+    ctx->omega_band_rad_s = (omega_band_rad_s > 0.0f) ? omega_band_rad_s : 0.0f;
+    ctx->iq_acc_a = 0.0f;
+    ctx->iq_visc_a = 0.0f;
+    ctx->iq_coul_a = 0.0f;
+}
+
+static inline float SpeedFf_SoftSign(float x, float band)
+{
+    if (band <= 0.0f)
+    {
+        return (x > 0.0f) ? 1.0f : ((x < 0.0f) ? -1.0f : 0.0f);
+    }
+    const float s = x / band;
+    if (s > 1.0f)
+    {
+        return 1.0f;
+    }
+    if (s < -1.0f)
+    {
+        return -1.0f;
+    }
+    return s;
+}
+
+/* acc / omega 为给定轨迹的加速度与速度（机械 rad），返回前馈 Iq（A） */
+static inline float SpeedFf_Iq(SpeedFf *ctx, float acc_rad_s2, float omega_rad_s)
+{
+    if ((ctx == 0) || (ctx->kt_nm_a <= 0.0f))
+    {
+        return 0.0f;
+    }
+    const float inv_kt = 1.0f / ctx->kt_nm_a;
+    ctx->iq_acc_a = ctx->j_kgm2 * acc_rad_s2 * inv_kt;
+    ctx->iq_visc_a = ctx->b_nms * omega_rad_s * inv_kt;
+    ctx->iq_coul_a = ctx->tc_nm * SpeedFf_SoftSign(omega_rad_s, ctx->omega_band_rad_s) * inv_kt;
+    return ctx->iq_acc_a + ctx->iq_visc_a + ctx->iq_coul_a;
+}
+
+#endif /* COMPONENTS_SPEED_FF_H */
@@ -0,0 +1,259 @@
+#ifndef COMPONENTS_SPEED_IDENT_H
+#define COMPONENTS_SPEED_IDENT_H
+
+#include <math.h>
+#include <stdint.h>
+
+/*
+ * 机械参数在线辨识（速度环自整定用），速度环节拍里跑，电流环闭环给 Iq：
+ *   +I 加速到 +omega_t -> 滑行 -> -I 反向到 -omega_t -> 滑行，重复两次，最后反向制动到接近 0。
+ * 模型 J*omega' = Kt*iq - B*omega - Tc*sign(omega)，按窗口积分形式做 RLS（不对速度逐拍求导）：
+ *   (omega_end - omega_start) / T = [mean(iq), -mean(omega)/omega_t, -mean(sign)] * [Kt/J, B*omega_t/J, Tc/J]'
+ * 回归量里的 iq 用下发的指令（电流环远快于机械，噪声也不进回归量）；omega 缩放到 1 附近，三个参数同一量级，float 的 P 阵够用。
+ * 每段开头丢掉 skip 拍（电流环/PLL 的过渡），窗口不跨段。Kt 视为已知。
+ */
+typedef enum
+{
+    SPD_IDENT_IDLE = 0,
+    SPD_IDENT_RUN,
+    SPD_IDENT_DONE,
+    SPD_IDENT_FAIL,
+} SpeedIdentState;
+
+#define SPD_IDENT_NP (3U)
+#define SPD_IDENT_SEG_BRAKE (8U) /* 0..7：+I / 滑行 / -I / 滑行 两轮；8：制动 */
+
+typedef struct
+{
+    SpeedIdentState state;
+    float i_test_a;
+    float omega_test_rad_s;
+    float kt_nm_a;
+    float dt_s;
+    uint32_t coast_ticks;
+    uint32_t seg_max_ticks;
+    uint32_t win_ticks;
+    uint32_t skip_ticks;
+
+    uint8_t seg;
+    uint32_t seg_tick;
+    float iq_cmd_a; /* 上一拍下发、本拍之前一直作用的 Iq */
+
+    /* 当前窗口 */
+    uint32_t win_tick;
+    float win_omega0;
+    float acc_iq;
+    float acc_omega;
+    float acc_sgn;
+
+    /* RLS */
+    float theta[SPD_IDENT_NP];
+    float p[SPD_IDENT_NP][SPD_IDENT_NP];
+    uint32_t n_upd;
+
+    float j_kgm2;
+    float b_nms;
+    float tc_nm;
+} SpeedIdent;
+
+static inline void SpeedIdent_Start(SpeedIdent *ctx, float i_test_a, float omega_test_rad_s, float kt_nm_a, float dt_s,
+                                    uint32_t coast_ticks, uint32_t seg_max_ticks, uint32_t win_ticks,
+                                    uint32_t skip_ticks)
+{
+    if ((ctx == 0) || (i_test_a <= 0.0f) || (omega_test_rad_s <= 0.0f) || (kt_nm_a <= 0.0f) || (dt_s <= 0.0f) ||
+        (win_ticks == 0U) || (seg_max_ticks == 0U))
+    {
+        return;
+    }
+    ctx->i_test_a = i_test_a;
+    ctx->omega_test_rad_s = omega_test_rad_s;
+    ctx->kt_nm_a = kt_nm_a;
+    ctx->dt_s = dt_s;
+    ctx->coast_ticks = coast_ticks;
+    ctx->seg_max_ticks = seg_max_ticks;
+    ctx->win_ticks = win_ticks;
+    ctx->skip_ticks = skip_ticks;
+
+    ctx->seg = 0U;
+    ctx->seg_tick = 0U;
+    ctx->iq_cmd_a = 0.0f;
+    ctx->win_tick = 0U;
+    ctx->win_omega0 = 0.0f;
+    ctx->acc_iq = 0.0f;
+    ctx->acc_omega = 0.0f;
+    ctx->acc_sgn = 0.0f;
+    for (uint8_t i = 0U; i < SPD_IDENT_NP; ++i)
+    {
+        ctx->theta[i] = 0.0f;
+        for (uint8_t j = 0U; j < SPD_IDENT_NP; ++j)
+        {
+            ctx->p[i][j] = (i == j) ? 1.0e8f : 0.0f;
+        }
+    }
+    ctx->n_upd = 0U;
+    ctx->j_kgm2 = 0.0f;
+    ctx->b_nms = 0.0f;
+    ctx->tc_nm = 0.0f;
+    ctx->state = SPD_IDENT_RUN;
+}
+
+static inline void SpeedIdent_Abort(SpeedIdent *ctx)
+{
+    if (ctx == 0)
+    {
+        return;
+    }
+    ctx->state = SPD_IDENT_IDLE;
+    ctx->iq_cmd_a = 0.0f;
+}
+
+/* 一次 RLS 更新（遗忘因子 1）：k = P*phi / (1 + phi'*P*phi)，theta += k*e，P -= k*phi'*P */
+static inline void SpeedIdent_RlsUpdate(SpeedIdent *ctx, const float phi[SPD_IDENT_NP], float y)
+{
+    float pphi[SPD_IDENT_NP];
+    float den = 1.0f;
+    float y_hat = 0.0f;
+    for (uint8_t i = 0U; i < SPD_IDENT_NP; ++i)
+    {
+        pphi[i] = 0.0f;
+        for (uint8_t j = 0U; j < SPD_IDENT_NP; ++j)
+        {
+            pphi[i] += ctx->p[i][j] * phi[j];
+        }
+        den += phi[i] * pphi[i];
+        y_hat += phi[i] * ctx->theta[i];
+    }
+    const float e = y - y_hat;
+    const float inv_den = 1.0f / den;
+    for (uint8_t i = 0U; i < SPD_IDENT_NP; ++i)
+    {
+        ctx->theta[i] += pphi[i] * inv_den * e;
+    }
+    /* P 对称，pphi 同时是 phi'*P 的转置 */
+    for (uint8_t i = 0U; i < SPD_IDENT_NP; ++i)
+    {
+        for (uint8_t j = 0U; j < SPD_IDENT_NP; ++j)
+        {
+            ctx->p[i][j] -= pphi[i] * pphi[j] * inv_den;
+        }
+    }
+    ctx->n_upd++;
+}
+
+static inline void SpeedIdent_NextSeg(SpeedIdent *ctx, float omega_rad_s)
+{
+    ctx->seg++;
+    ctx->seg_tick = 0U;
+    ctx->win_tick = 0U;
+    ctx->win_omega0 = omega_rad_s;
+}
+
+/* 辨识结束：theta -> J / B / Tc；Kt/J 不为正或有效窗口太少判失败 */
+static inline void SpeedIdent_Finish(SpeedIdent *ctx)
+{
+    ctx->iq_cmd_a = 0.0f;
+    if ((ctx->n_upd < (4U * SPD_IDENT_NP)) || (ctx->theta[0] <= 0.0f))
+    {
+        ctx->state = SPD_IDENT_FAIL;
+        return;
+    }
+    ctx->j_kgm2 = ctx->kt_nm_a / ctx->theta[0];
+    ctx->b_nms = ctx->theta[1] * ctx->j_kgm2 / ctx->omega_test_rad_s;
+    ctx->tc_nm = ctx->theta[2] * ctx->j_kgm2;
+    ctx->state = SPD_IDENT_DONE;
+}
+
+/* 每个速度环节拍调用一次，omega 为速度反馈（与 iq 同方向），返回本拍要下发的 Iq */
+static inline float SpeedIdent_Tick(SpeedIdent *ctx, float omega_rad_s)
+{
+    if ((ctx == 0) || (ctx->state != SPD_IDENT_RUN))
+    {
+        return 0.0f;
+    }
+
+    const float w_t = ctx->omega_test_rad_s;
+    if (fabsf(omega_rad_s) > (1.5f * w_t))
+    {
+        /* 超速：参数/方向不对，直接放弃 */
+        ctx->iq_cmd_a = 0.0f;
+        ctx->state = SPD_IDENT_FAIL;
+        return 0.0f;
+    }
+
+    /* 上一拍的 Iq 作用了一个节拍，先把这一段记进窗口 */
+    ctx->seg_tick++;
+    if (ctx->seg_tick <= ctx->skip_ticks)
+    {
+        ctx->win_omega0 = omega_rad_s;
+    }
+    else
+    {
+        ctx->acc_iq = (ctx->win_tick == 0U) ? ctx->iq_cmd_a : (ctx->acc_iq + ctx->iq_cmd_a);
+        ctx->acc_omega = (ctx->win_tick == 0U) ? omega_rad_s : (ctx->acc_omega + omega_rad_s);
+        const float sgn = (omega_rad_s > 0.0f) ? 1.0f : ((omega_rad_s < 0.0f) ? -1.0f : 0.0f);
+        ctx->acc_sgn = (ctx->win_tick == 0U) ? sgn : (ctx->acc_sgn + sgn);
+        ctx->win_tick++;
+        if (ctx->win_tick >= ctx->win_ticks)
+        {
+            const float inv_n = 1.0f / (float)ctx->win_tick;
+            const float phi[SPD_IDENT_NP] = {
+                ctx->acc_iq * inv_n,
+                -(ctx->acc_omega * inv_n) / w_t,
+                -(ctx->acc_sgn * inv_n),
+            };
+            const float y = (omega_rad_s - ctx->win_omega0) / ((float)ctx->win_tick * ctx->dt_s);
+            SpeedIdent_RlsUpdate(ctx, phi, y);
+            ctx->win_tick = 0U;
+            ctx->win_omega0 = omega_rad_s;
+        }
+    }
+
+    /* 段切换 */
+    if ((ctx->seg_tick >= ctx->seg_max_ticks) && ((ctx->seg & 1U) == 0U) && (ctx->seg != SPD_IDENT_SEG_BRAKE))
+    {
+        /* 加速段超时：堵转或 I_test 不够 */
+        ctx->iq_cmd_a = 0.0f;
+        ctx->state = SPD_IDENT_FAIL;
+        return 0.0f;
+    }
+    if (ctx->seg == SPD_IDENT_SEG_BRAKE)
+    {
+        if ((fabsf(omega_rad_s) < (0.1f * w_t)) || (ctx->seg_tick >= ctx->seg_max_ticks))
+        {
+            SpeedIdent_Finish(ctx);
+            return 0.0f;
+        }
+    }
+    else if ((ctx->seg & 1U) != 0U)
+    {
+        if (ctx->seg_tick >= ctx->coast_ticks)
+        {
+            SpeedIdent_NextSeg(ctx, omega_rad_s);
+        }
+    }
+    else
+    {
+        const uint8_t fwd = ((ctx->seg & 3U) == 0U) ? 1U : 0U;
+        if (((fwd != 0U) && (omega_rad_s >= w_t)) || ((fwd == 0U) && (omega_rad_s <= -w_t)))
+        {
+            SpeedIdent_NextSeg(ctx, omega_rad_s);
+        }
+    }
+
+    /* 本段 Iq */
+    if (ctx->seg == SPD_IDENT_SEG_BRAKE)
+    {
+        ctx->iq_cmd_a = (omega_rad_s > 0.0f) ? -ctx->i_test_a : ctx->i_test_a;
+    }
+    else if ((ctx->seg & 1U) != 0U)
+    {
+        ctx->iq_cmd_a = 0.0f;
+    }
+    else
+    {
+        ctx->iq_cmd_a = ((ctx->seg & 3U) == 0U) ? ctx->i_test_a : -ctx->i_test_a;
+    }
+    return ctx->iq_cmd_a;
+}
+
+#endif /* COMPONENTS_SPEED_IDENT_H */
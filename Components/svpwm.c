@@ -1,5 +1,28 @@
 #include "svpwm.h"
 
+#include <math.h>
+
+#define SVPWM_LINEAR_LIMIT_PU (0.57735026919f) /* 1/sqrt(3)，六边形内切圆 */
+#define SVPWM_OVM1_LIMIT_PU (0.60569670f)      /* 区域 I 上限：轨迹完全落到六边形上（MI = 0.9514） */
+#define SVPWM_SECTOR_RAD (1.04719755120f)      /* pi/3 */
+#define SVPWM_OVM_TABLE_N (16U)
+
+/*
+ * 过调制查表（离线数值积分生成，按基波相等求解）：
+ * - g_ovm1_radius：区域 I，给定基波幅值（1/sqrt(3)..0.6057 等分 16 段）-> 截断前的圆半径；
+ * - g_ovm2_hold：区域 II，给定基波幅值（0.6057..2/pi 等分 16 段）-> 扇区两端顶点保持角（rad），
+ *   保持角之间沿六边形边移动，角度按 [hold, pi/3-hold] -> [0, pi/3] 线性拉伸，轨迹连续；hold=pi/6 即六拍。
+ */
+static const float g_ovm1_radius[SVPWM_OVM_TABLE_N + 1U] = {
+    0.577350f, 0.579331f, 0.581534f, 0.583925f, 0.586504f, 0.589281f, 0.592272f, 0.595503f, 0.599006f,
+    0.602828f, 0.607034f, 0.611718f, 0.617027f, 0.623205f, 0.630736f, 0.640862f, 0.666667f,
+};
+
+static const float g_ovm2_hold[SVPWM_OVM_TABLE_N + 1U] = {
+    0.000000f, 0.016854f, 0.034256f, 0.052267f, 0.070960f, 0.090423f, 0.110765f, 0.132124f, 0.154677f,
+    0.178656f, 0.204385f, 0.232326f, 0.263191f, 0.298178f, 0.339624f, 0.393566f, 0.523599f,
+};
+
 static float Svpwm_Max3(float a, float b, float c)
 {
     float m = (a > b) ? a : b;
@@ -57,8 +80,65 @@ static uint8_t Svpwm_Sector(float u_alpha, float u_beta)
     }
 }
 
-/* 用α β轴给定电压进行反Clarke变换，零序电压注入算出三相占空比*/
-void Svpwm_Calc(float u_alpha, float u_beta, SvpwmOut *out)
+/* 在 [lo, hi] 上等分 SVPWM_OVM_TABLE_N 段的表中线性插值 */
+static float Svpwm_TableLerp(const float *table, float x, float lo, float hi)
+{
+    float pos = ((x - lo) / (hi - lo)) * (float)SVPWM_OVM_TABLE_N;
+    if (pos <= 0.0f)
+    {
+        return table[0];
+    }
+    if (pos >= (float)SVPWM_OVM_TABLE_N)
+    {
+        return table[SVPWM_OVM_TABLE_N];
+    }
+    const uint32_t i = (uint32_t)pos;
+    const float f = pos - (float)i;
+    return table[i] + (f * (table[i + 1U] - table[i]));
+}
+
+/* 扇区内角度 phi（0..pi/3，0 为扇区起始顶点方向）处六边形边界的半径 */
+static float Svpwm_HexRadius(float phi)
+{
+    return SVPWM_LINEAR_LIMIT_PU / cosf(phi - (0.5f * SVPWM_SECTOR_RAD));
+}
+
+/* 占空比贴 0/1 的相标记到 clamp_low / clamp_high（留一点浮点余量） */
+static void Svpwm_MarkClamp(SvpwmOut *out)
+{
+    const float eps = 1.0e-4f;
+    const float d[3] = {out->duty_a, out->duty_b, out->duty_c};
+
+    out->clamp_low = 0U;
+    out->clamp_high = 0U;
+    for (uint32_t i = 0U; i < 3U; ++i)
+    {
+        if (d[i] <= eps)
+        {
+            out->clamp_low |= (uint8_t)(1U << i);
+        }
+        else if (d[i] >= (1.0f - eps))
+        {
+            out->clamp_high |= (uint8_t)(1U << i);
+        }
+    }
+}
+
+/* 三相中幅值最大的一相的下标（DPWM0/1 用） */
+static uint32_t Svpwm_AbsMaxIndex(float a, float b, float c)
+{
+    const float fa = fabsf(a);
+    const float fb = fabsf(b);
+    const float fc = fabsf(c);
+    if ((fa >= fb) && (fa >= fc))
+    {
+        return 0U;
+    }
+    return (fb >= fc) ? 1U : 2U;
+}
+
+/* 用α β轴给定电压进行反Clarke变换，零序电压注入算出三相占空比 */
+void Svpwm_CalcZs(float u_alpha, float u_beta, SvpwmZsMode mode, SvpwmOut *out)
 {
     if (out == 0)
     {
@@ -66,21 +146,128 @@ void Svpwm_Calc(float u_alpha, float u_beta, SvpwmOut *out)
     }
 
     /* Inverse Clarke Transform */
-    float va = u_alpha;
-    float vb = (-0.5f * u_alpha) + (0.86602540378f * u_beta);
-    float vc = (-0.5f * u_alpha) - (0.86602540378f * u_beta);
-
-    /* Min-max common-mode injection SVPWM (u_* in V/Vbus, typical magnitude <= ~0.577) */
-    const float v_max = Svpwm_Max3(va, vb, vc);
-    const float v_min = Svpwm_Min3(va, vb, vc);
-    const float v_off = -0.5f * (v_max + v_min);
-
-    va += v_off;
-    vb += v_off;
-    vc += v_off;
-
-    out->duty_a = Svpwm_Clamp01(va + 0.5f);
-    out->duty_b = Svpwm_Clamp01(vb + 0.5f);
-    out->duty_c = Svpwm_Clamp01(vc + 0.5f);
+    float v[3] = {
+        u_alpha,
+        (-0.5f * u_alpha) + (0.86602540378f * u_beta),
+        (-0.5f * u_alpha) - (0.86602540378f * u_beta),
+    };
+
+    /* u_* in V/Vbus, typical magnitude <= ~0.577 */
+    const float v_max = Svpwm_Max3(v[0], v[1], v[2]);
+    const float v_min = Svpwm_Min3(v[0], v[1], v[2]);
+    float v_off = -0.5f * (v_max + v_min); /* min-max common-mode injection */
+
+    switch (mode)
+    {
+    case SVPWM_ZS_DPWMMAX:
+        v_off = 0.5f - v_max;
+        break;
+    case SVPWM_ZS_DPWMMIN:
+        v_off = -0.5f - v_min;
+        break;
+    case SVPWM_ZS_DPWM1:
+    case SVPWM_ZS_DPWM0:
+    {
+        /* DPWM1 按当前矢量选幅值最大相；DPWM0 用超前 30° 的矢量选相，钳位方向跟随该相电压符号 */
+        uint32_t idx = Svpwm_AbsMaxIndex(v[0], v[1], v[2]);
+        if (mode == SVPWM_ZS_DPWM0)
+        {
+            const float c30 = 0.86602540378f;
+            const float ra = (c30 * u_alpha) - (0.5f * u_beta);
+            const float rb = (0.5f * u_alpha) + (c30 * u_beta);
+            idx = Svpwm_AbsMaxIndex(ra, (-0.5f * ra) + (c30 * rb), (-0.5f * ra) - (c30 * rb));
+        }
+        v_off = (v[idx] >= 0.0f) ? (0.5f - v[idx]) : (-0.5f - v[idx]);
+        break;
+    }
+    case SVPWM_ZS_CONTINUOUS:
+    default:
+        break;
+    }
+
+    out->duty_a = Svpwm_Clamp01(v[0] + v_off + 0.5f);
+    out->duty_b = Svpwm_Clamp01(v[1] + v_off + 0.5f);
+    out->duty_c = Svpwm_Clamp01(v[2] + v_off + 0.5f);
     out->sector = Svpwm_Sector(u_alpha, u_beta);
+    out->ovm_region = (uint8_t)SVPWM_OVM_LINEAR;
+    Svpwm_MarkClamp(out);
+}
+
+void Svpwm_Calc(float u_alpha, float u_beta, SvpwmOut *out)
+{
+    Svpwm_CalcZs(u_alpha, u_beta, SVPWM_ZS_CONTINUOUS, out);
+}
+
+/*
+ * 带过调制的 SVPWM：线性区与 Svpwm_Calc 完全一致；超出内切圆后按查表修正参考矢量，
+ * 使输出基波幅值等于给定幅值，一直连续过渡到六拍（|u| >= 2/pi）。
+ * 过调制区至少一相占空比贴 0/1，下桥臂窗口变短或消失，采样由上层（pair_valid=0 时的电流预测）兜底。
+ */
+void Svpwm_CalcOvm(float u_alpha, float u_beta, SvpwmOut *out)
+{
+    if (out == 0)
+    {
+        return;
+    }
+
+    const float mag = sqrtf((u_alpha * u_alpha) + (u_beta * u_beta));
+    if (mag <= SVPWM_LINEAR_LIMIT_PU)
+    {
+        Svpwm_Calc(u_alpha, u_beta, out);
+        return;
+    }
+
+    float theta = atan2f(u_beta, u_alpha);
+    if (theta < 0.0f)
+    {
+        theta += 2.0f * 3.14159265359f;
+    }
+    uint32_t k = (uint32_t)(theta / SVPWM_SECTOR_RAD);
+    if (k > 5U)
+    {
+        k = 5U;
+    }
+    const float sector_base = (float)k * SVPWM_SECTOR_RAD;
+    const float phi = theta - sector_base;
+
+    float out_phi = phi;
+    float out_mag = 0.0f;
+    uint8_t region = (uint8_t)SVPWM_OVM_REGION_1;
+    if (mag < SVPWM_OVM1_LIMIT_PU)
+    {
+        /* 区域 I：放大圆半径，超出六边形的部分沿原角度截断 */
+        const float r = Svpwm_TableLerp(g_ovm1_radius, mag, SVPWM_LINEAR_LIMIT_PU, SVPWM_OVM1_LIMIT_PU);
+        const float r_hex = Svpwm_HexRadius(phi);
+        out_mag = (r < r_hex) ? r : r_hex;
+    }
+    else
+    {
+        /* 区域 II / 六拍：扇区两端保持在顶点，中间沿六边形边移动 */
+        const float hold = Svpwm_TableLerp(g_ovm2_hold, mag, SVPWM_OVM1_LIMIT_PU, SVPWM_OVM_SIX_STEP_PU);
+        const float half = 0.5f * SVPWM_SECTOR_RAD;
+        region = (uint8_t)SVPWM_OVM_REGION_2;
+        if (hold >= (half - 1.0e-4f))
+        {
+            out_phi = (phi < half) ? 0.0f : SVPWM_SECTOR_RAD;
+            region = (uint8_t)SVPWM_OVM_SIX_STEP;
+        }
+        else if (phi <= hold)
+        {
+            out_phi = 0.0f;
+        }
+        else if (phi >= (SVPWM_SECTOR_RAD - hold))
+        {
+            out_phi = SVPWM_SECTOR_RAD;
+        }
+        else
+        {
+            out_phi = (phi - hold) * (half / (half - hold));
+        }
+        out_mag = Svpwm_HexRadius(out_phi);
+    }
+
+    const float ang = sector_base + out_phi;
+    Svpwm_Calc(out_mag * cosf(ang), out_mag * sinf(ang), out);
+    out->sector = (uint8_t)(k + 1U); /* 顶点处修正后矢量的扇区判定不唯一，沿用给定矢量的扇区 */
+    out->ovm_region = region;
 }
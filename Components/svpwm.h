@@ -8,10 +8,37 @@ typedef struct
     float duty_a;
     float duty_b;
     float duty_c;
-    uint8_t sector; /* 1..6, 0 = invalid */
+    uint8_t sector;     /* 1..6, 0 = invalid */
+    uint8_t ovm_region; /* SvpwmOvmRegion：过调制区域，Svpwm_Calc 恒为 LINEAR */
+    uint8_t clamp_low;  /* bit0..2 = A/B/C：占空比钳在 0（整周期下桥臂导通，采样窗口最长） */
+    uint8_t clamp_high; /* bit0..2 = A/B/C：占空比钳在 1（没有下桥臂窗口） */
 } SvpwmOut;
 
+/* 零序注入方式：CONTINUOUS 为 min-max 注入（Svpwm_Calc），其余为不连续 PWM，每时刻有一相不开关 */
+typedef enum
+{
+    SVPWM_ZS_CONTINUOUS = 0,
+    SVPWM_ZS_DPWM0,   /* 钳位区间相对 DPWM1 超前 30° */
+    SVPWM_ZS_DPWM1,   /* 钳住幅值最大的一相（相电压峰值两侧各 30°），功率因数接近 1 时开关损耗最低 */
+    SVPWM_ZS_DPWMMAX, /* 始终钳最高相到 1 */
+    SVPWM_ZS_DPWMMIN, /* 始终钳最低相到 0：总有一相整周期下桥臂导通，三电阻采样最友好 */
+    SVPWM_ZS_COUNT,
+} SvpwmZsMode;
+
+typedef enum
+{
+    SVPWM_OVM_LINEAR = 0, /* |u| <= 1/sqrt(3)：内切圆线性区 */
+    SVPWM_OVM_REGION_1,   /* 1/sqrt(3) < |u| < 0.6057：圆 + 六边形截断，半径增益补偿基波 */
+    SVPWM_OVM_REGION_2,   /* 0.6057 <= |u| < 2/pi：六边形 + 顶点保持角 */
+    SVPWM_OVM_SIX_STEP,   /* |u| >= 2/pi：六拍 */
+} SvpwmOvmRegion;
+
+/* 过调制可达的最大基波幅值（六拍，母线电压标幺值） */
+#define SVPWM_OVM_SIX_STEP_PU (0.63661977237f) /* 2/pi */
+
 void Svpwm_Calc(float u_alpha, float u_beta, SvpwmOut *out);
+void Svpwm_CalcOvm(float u_alpha, float u_beta, SvpwmOut *out);
+void Svpwm_CalcZs(float u_alpha, float u_beta, SvpwmZsMode mode, SvpwmOut *out);
 
 #endif /* COMPONENTS_SVPWM_H */
 
@@ -0,0 +1,101 @@
+#ifndef COMPONENTS_THERMAL_MODEL_H
+#define COMPONENTS_THERMAL_MODEL_H
+
+#include <math.h>
+#include <stdint.h>
+
+/*
+ * I^2t 热模型（Foster 形式的 RC 网络，1~2 阶），输入为窗口内 |i|^2 的均值：
+ *   rise_k += (1 - exp(-dt/tau_k)) * (gain_k * i2 - rise_k)，T = T_amb + sum(rise_k)
+ * gain_k 为该支路的稳态温升系数（degC/A^2），两阶即绕组对外壳（快）+ 外壳对环境（慢），gain_1 = 0 退化为一阶。
+ * 按零阶保持精确离散，dt 取慢速节拍（10ms 量级）也稳定。
+ * 降额：T <= t_derate 给 i_peak，到 t_max 线性降到持续电流 i_cont = sqrt((t_max - T_amb) / sum(gain))，
+ * 以 i_cont 长期运行稳态正好到 t_max，不会越过。
+ */
+#define THERMAL_RC_MAX_POLES (2U)
+
+typedef struct
+{
+    float gain[THERMAL_RC_MAX_POLES]; /* degC / A^2 */
+    float k[THERMAL_RC_MAX_POLES];    /* 1 - exp(-dt/tau) */
+    float rise[THERMAL_RC_MAX_POLES]; /* 各支路温升 */
+    float t_amb_c;
+    float t_derate_c;
+    float t_max_c;
+    float i_cont_a;
+
+    float temp_c; /* 输出 */
+} ThermalRc;
+
+static inline void ThermalRc_Reset(ThermalRc *ctx)
+{
+    if (ctx == 0)
+    {
+        return;
+    }
+    for (uint8_t i = 0U; i < THERMAL_RC_MAX_POLES; ++i)
+    {
+        ctx->rise[i] = 0.0f;
+    }
+    ctx->temp_c = ctx->t_amb_c;
+}
+
+/* tau1 <= 0 或 gain1 <= 0 时只用第一阶 */
+static inline void ThermalRc_Init(ThermalRc *ctx, float dt_s, float gain0, float tau0_s, float gain1, float tau1_s,
+                                  float t_amb_c, float t_derate_c, float t_max_c)
+{
+    if ((ctx == 0) || (dt_s <= 0.0f) || (gain0 <= 0.0f) || (tau0_s <= 0.0f) || (t_max_c <= t_amb_c) ||
+        (t_derate_c >= t_max_c))
+    {
+        return;
+    }
+    const uint8_t two = ((gain1 > 0.0f) && (tau1_s > 0.0f)) ? 1U : 0U;
+    ctx->gain[0] = gain0;
+    ctx->k[0] = 1.0f - expf(-dt_s / tau0_s);
+    ctx->gain[1] = (two != 0U) ? gain1 : 0.0f;
+    ctx->k[1] = (two != 0U) ? (1.0f - expf(-dt_s / tau1_s)) : 0.0f;
+    ctx->t_amb_c = t_amb_c;
+    ctx->t_derate_c = t_derate_c;
+    ctx->t_max_c = t_max_c;
+    ctx->i_cont_a = sqrtf((t_max_c - t_amb_c) / (ctx->gain[0] + ctx->gain[1]));
+    ThermalRc_Reset(ctx);
+}
+
+/* 每个慢速节拍调用一次，i2 为节拍内 |i|^2 的均值（A^2），返回温度估计 */
+static inline float ThermalRc_Step(ThermalRc *ctx, float i2)
+{
+    if (ctx == 0)
+    {
+        return 0.0f;
+    }
+    float t = ctx->t_amb_c;
+    for (uint8_t i = 0U; i < THERMAL_RC_MAX_POLES; ++i)
+    {
+        ctx->rise[i] += ctx->k[i] * ((ctx->gain[i] * i2) - ctx->rise[i]);
+        t += ctx->rise[i];
+    }
+    ctx->temp_c = t;
+    return t;
+}
+
+/* 当前温度下允许的电流幅值（不超过 i_peak） */
+static inline float ThermalRc_Derate(const ThermalRc *ctx, float i_peak_a)
+{
+    if ((ctx == 0) || (ctx->t_max_c <= ctx->t_derate_c))
+    {
+        return i_peak_a;
+    }
+    const float i_cont = (ctx->i_cont_a < i_peak_a) ? ctx->i_cont_a : i_peak_a;
+    if (ctx->temp_c <= ctx->t_derate_c)
+    {
+        return i_peak_a;
+    }
+    if (ctx->temp_c >= ctx->t_max_c)
+    {
+        return i_cont;
+    }
+    const float f = (ctx->temp_c - ctx->t_derate_c) / (ctx->t_max_c - ctx->t_derate_c);
+    return i_peak_a + (f * (i_cont - i_peak_a));
+}
+
+#endif /* COMPONENTS_THERMAL_MODEL_H */